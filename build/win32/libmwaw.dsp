@@ -399,6 +399,10 @@ SOURCE=..\..\src\lib\MWAWDocument.cxx
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\lib\MWAWFileStream.cxx
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\lib\MWAWFont.cxx
 # End Source File
 # Begin Source File
@@ -483,6 +487,10 @@ SOURCE=..\..\src\lib\MWAWPropertyHandler.cxx
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\lib\MWAWPropertyListCache.cxx
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\lib\MWAWRSRCParser.cxx
 # End Source File
 # Begin Source File
@@ -503,6 +511,10 @@ SOURCE=..\..\src\lib\MWAWSpreadsheetListener.cxx
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\lib\MWAWStreamView.cxx
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\lib\MWAWStringStream.cxx
 # End Source File
 # Begin Source File
@@ -919,6 +931,10 @@ SOURCE=..\..\inc\libmwaw\MWAWDocument.hxx
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\inc\libmwaw\MWAWFileStream.hxx
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\lib\MWAWEntry.hxx
 # End Source File
 # Begin Source File
@@ -1019,6 +1035,10 @@ SOURCE=..\..\src\lib\MWAWPropertyHandler.hxx
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\lib\MWAWPropertyListCache.hxx
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\lib\MWAWRSRCParser.hxx
 # End Source File
 # Begin Source File
@@ -1039,6 +1059,10 @@ SOURCE=..\..\src\lib\MWAWSpreadsheetListener.hxx
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\lib\MWAWStreamView.hxx
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\lib\MWAWStringStream.hxx
 # End Source File
 # Begin Source File
@@ -176,6 +176,27 @@ public:
       \note encryption enum appears with MWAW_TEXT_VERSION==2 */
   static MWAWLIB Confidence isFileFormatSupported(librevenge::RVNGInputStream *input, Type &type, Kind &kind);
 
+  /** an opaque structure which keeps the result of a file analysis:
+      the decoded input, the resource fork parser and the document header.
+
+      \sa isFileFormatSupported, parse, freePreparedDocument */
+  class PreparedDocument;
+
+  /** Analyzes the content of an input stream to see if it can be parsed and
+      keeps the analysis result to avoid redoing it when parsing the document.
+      \param input The input stream
+      \param type The document type ( filled if the file is supported )
+      \param kind The document kind ( filled if the file is supported )
+      \param prepared Set to the analysis result if the file is supported, to 0 otherwise
+      \return A confidence value which represents the likelyhood that the content from
+      the input stream can be parsed
+
+      \note the prepared document must be freed with freePreparedDocument and
+      must not be used once input is destroyed */
+  static MWAWLIB Confidence isFileFormatSupported(librevenge::RVNGInputStream *input, Type &type, Kind &kind, PreparedDocument *&prepared);
+  /** Frees a prepared document created by isFileFormatSupported */
+  static MWAWLIB void freePreparedDocument(PreparedDocument *prepared);
+
   // ------------------------------------------------------------
   // the different main parsers
   // ------------------------------------------------------------
@@ -189,6 +210,12 @@ public:
 
    \note password appears with MWAW_TEXT_VERSION==2 */
   static MWAWLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password=0);
+  /** Parses a text document analyzed by isFileFormatSupported.
+     \param prepared The prepared document
+     \param documentInterface A librevenge::RVNGTextInterface implementation
+     \param password The file password
+  */
+  static MWAWLIB Result parse(PreparedDocument *prepared, librevenge::RVNGTextInterface *documentInterface, char const *password=0);
 
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGDrawingInterface class implementation when needed. This is often commonly called the
@@ -199,6 +226,12 @@ public:
 
    \note Reserved for future use. Actually, it only returns MWAW_R_UNKNOWN_ERROR. */
   static MWAWLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password=0);
+  /** Parses a graphic document analyzed by isFileFormatSupported.
+     \param prepared The prepared document
+     \param documentInterface A librevenge::RVNGDrawingInterface implementation
+     \param password The file password
+  */
+  static MWAWLIB Result parse(PreparedDocument *prepared, librevenge::RVNGDrawingInterface *documentInterface, char const *password=0);
 
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGPresentationInterface class implementation when needed. This is often commonly called the
@@ -210,6 +243,12 @@ public:
      \note Reserved for future use. Actually, it only returns MWAW_R_UNKNOWN_ERROR.
   */
   static MWAWLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password=0);
+  /** Parses a presentation document analyzed by isFileFormatSupported.
+     \param prepared The prepared document
+     \param documentInterface A librevenge::RVNGPresentationInterface implementation
+     \param password The file password
+  */
+  static MWAWLIB Result parse(PreparedDocument *prepared, librevenge::RVNGPresentationInterface *documentInterface, char const *password=0);
 
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGSpreadsheetInterface class implementation when needed. This is often commonly called the
@@ -221,6 +260,12 @@ public:
      \note this function appears with MWAW_SPREADSHEET_VERSION==1 in libmwaw-0.3
   */
   static MWAWLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password=0);
+  /** Parses a spreadsheet document analyzed by isFileFormatSupported.
+     \param prepared The prepared document
+     \param documentInterface A librevenge::RVNGSpreadsheetInterface implementation
+     \param password The file password
+  */
+  static MWAWLIB Result parse(PreparedDocument *prepared, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password=0);
 
   // ------------------------------------------------------------
   // decoders of the embedded zones created by libmwaw
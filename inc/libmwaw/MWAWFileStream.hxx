@@ -0,0 +1,93 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+/** \file MWAWFileStream.hxx
+ * libmwaw API: a file input stream which maps the file in memory
+ *
+ * \see libmwaw.hxx
+ */
+#ifndef MWAWFILESTREAM_HXX
+#define MWAWFILESTREAM_HXX
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "MWAWDocument.hxx"
+
+class MWAWFileStreamPrivate;
+
+/** a librevenge::RVNGInputStream which maps a file in memory
+
+    This class can be used instead of librevenge::RVNGFileStream to
+    read a file: when the file can be mapped, the pointers returned by
+    read are views in the mapping, so the data are never copied in an
+    intermediate buffer. If the file can not be mapped, its content is
+    loaded in memory.
+
+    \note the structured's protocol (OLE, zip, ...) is delegated to a
+    librevenge::RVNGFileStream which is only created when needed.
+ */
+class MWAWFileStream : public librevenge::RVNGInputStream
+{
+public:
+  //! constructor
+  explicit MWAWLIB MWAWFileStream(const char *filename);
+  //! destructor
+  MWAWLIB ~MWAWFileStream();
+
+  //! returns true if the file content is mapped in memory
+  MWAWLIB bool isMapped() const;
+
+  /**! reads numbytes data.
+
+   * \return a pointer to the read elements, this pointer stays valid until the stream is destroyed
+   */
+  MWAWLIB const unsigned char *read(unsigned long numBytes, unsigned long &numBytesRead);
+  //! returns actual offset position
+  MWAWLIB long tell();
+  /*! \brief seeks to a offset position, from actual, beginning or ending position
+   * \return 0 if ok
+   */
+  MWAWLIB int seek(long offset, librevenge::RVNG_SEEK_TYPE seekType);
+  //! returns true if we are at the end of the file
+  MWAWLIB bool isEnd();
+
+  //! returns true if the stream is ole, zip, ...
+  MWAWLIB bool isStructured();
+  //! returns the number of sub streams
+  MWAWLIB unsigned subStreamCount();
+  //! returns the ith sub streams name
+  MWAWLIB const char *subStreamName(unsigned id);
+  //! returns true if a substream with name exists
+  MWAWLIB bool existsSubStream(const char *name);
+  //! return a new stream for a ole zone
+  MWAWLIB librevenge::RVNGInputStream *getSubStreamByName(const char *name);
+  //! return a new stream for a ole zone
+  MWAWLIB librevenge::RVNGInputStream *getSubStreamById(unsigned id);
+
+private:
+  /// the file data
+  MWAWFileStreamPrivate *m_data;
+  MWAWFileStream(const MWAWFileStream &); // copy is not allowed
+  MWAWFileStream &operator=(const MWAWFileStream &); // assignment is not allowed
+};
+
+#endif
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
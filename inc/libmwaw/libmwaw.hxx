@@ -97,6 +97,7 @@ recommended to launch the tests in a empty repository...
 #define MWAW_TEXT_VERSION 2
 
 #include "MWAWDocument.hxx"
+#include "MWAWFileStream.hxx"
 
 #endif
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
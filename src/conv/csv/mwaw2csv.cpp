@@ -128,22 +128,26 @@ int main(int argc, char *argv[])
     return -1;
   }
   char const *file=argv[optind];
-  librevenge::RVNGFileStream input(file);
+  MWAWFileStream input(file);
 
   MWAWDocument::Type type;
   MWAWDocument::Kind kind;
   MWAWDocument::Confidence confidence = MWAWDocument::MWAW_C_NONE;
+  // keep the detection result to avoid analysing the file twice
+  MWAWDocument::PreparedDocument *prepared=0;
   try {
-    confidence = MWAWDocument::isFileFormatSupported(&input, type, kind);
+    confidence = MWAWDocument::isFileFormatSupported(&input, type, kind, prepared);
   }
   catch (...) {
     confidence = MWAWDocument::MWAW_C_NONE;
   }
-  if (confidence != MWAWDocument::MWAW_C_EXCELLENT) {
+  if (confidence != MWAWDocument::MWAW_C_EXCELLENT || !prepared) {
+    MWAWDocument::freePreparedDocument(prepared);
     fprintf(stderr,"ERROR: Unsupported file format!\n");
     return 1;
   }
   if (kind != MWAWDocument::MWAW_K_SPREADSHEET && kind != MWAWDocument::MWAW_K_DATABASE) {
+    MWAWDocument::freePreparedDocument(prepared);
     fprintf(stderr,"ERROR: not a spreadsheet!\n");
     return 1;
   }
@@ -154,7 +158,7 @@ int main(int argc, char *argv[])
     librevenge::RVNGCSVSpreadsheetGenerator listenerImpl(vec, generateFormula);
     listenerImpl.setSeparators(fieldSeparator, textSeparator, decSeparator);
     listenerImpl.setDTFormats(dateFormat.c_str(),timeFormat.c_str());
-    error= MWAWDocument::parse(&input, &listenerImpl);
+    error= MWAWDocument::parse(prepared, &listenerImpl);
   }
   catch (MWAWDocument::Result const &err) {
     error=err;
@@ -162,6 +166,7 @@ int main(int argc, char *argv[])
   catch (...) {
     error=MWAWDocument::MWAW_R_UNKNOWN_ERROR;
   }
+  MWAWDocument::freePreparedDocument(prepared);
   if (error == MWAWDocument::MWAW_R_FILE_ACCESS_ERROR)
     fprintf(stderr, "ERROR: File Exception!\n");
   else if (error == MWAWDocument::MWAW_R_PARSE_ERROR)
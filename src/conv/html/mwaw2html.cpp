@@ -88,26 +88,31 @@ int main(int argc, char *argv[])
   }
   file=argv[optind];
 
-  librevenge::RVNGFileStream input(file);
+  MWAWFileStream input(file);
 
   MWAWDocument::Type type;
   MWAWDocument::Kind kind;
   MWAWDocument::Confidence confidence = MWAWDocument::MWAW_C_NONE;
+  // keep the detection result to avoid analysing the file twice
+  MWAWDocument::PreparedDocument *prepared=0;
   try {
-    confidence = MWAWDocument::isFileFormatSupported(&input, type, kind);
+    confidence = MWAWDocument::isFileFormatSupported(&input, type, kind, prepared);
   }
   catch (...) {
     confidence = MWAWDocument::MWAW_C_NONE;
   }
-  if (confidence != MWAWDocument::MWAW_C_EXCELLENT) {
+  if (confidence != MWAWDocument::MWAW_C_EXCELLENT || !prepared) {
+    MWAWDocument::freePreparedDocument(prepared);
     printf("ERROR: Unsupported file format!\n");
     return 1;
   }
   if (type == MWAWDocument::MWAW_T_UNKNOWN) {
+    MWAWDocument::freePreparedDocument(prepared);
     printf("ERROR: can not determine the file type!\n");
     return 1;
   }
   if (kind != MWAWDocument::MWAW_K_TEXT) {
+    MWAWDocument::freePreparedDocument(prepared);
     printf("ERROR: find a not text document!\n");
     return 1;
   }
@@ -115,7 +120,7 @@ int main(int argc, char *argv[])
   librevenge::RVNGString document;
   try {
     librevenge::RVNGHTMLTextGenerator documentGenerator(document);
-    error = MWAWDocument::parse(&input, &documentGenerator);
+    error = MWAWDocument::parse(prepared, &documentGenerator);
   }
   catch (MWAWDocument::Result &err) {
     error=err;
@@ -123,6 +128,7 @@ int main(int argc, char *argv[])
   catch (...) {
     error=MWAWDocument::MWAW_R_UNKNOWN_ERROR;
   }
+  MWAWDocument::freePreparedDocument(prepared);
   if (error == MWAWDocument::MWAW_R_FILE_ACCESS_ERROR)
     fprintf(stderr, "ERROR: File Exception!\n");
   else if (error == MWAWDocument::MWAW_R_PARSE_ERROR)
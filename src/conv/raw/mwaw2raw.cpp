@@ -87,22 +87,26 @@ int main(int argc, char *argv[])
     return printUsage();
 
 
-  librevenge::RVNGFileStream input(file);
+  MWAWFileStream input(file);
 
   MWAWDocument::Type type;
   MWAWDocument::Kind kind;
   MWAWDocument::Confidence confidence = MWAWDocument::MWAW_C_NONE;
+  // keep the detection result to avoid analysing the file twice
+  MWAWDocument::PreparedDocument *prepared=0;
   try {
-    confidence = MWAWDocument::isFileFormatSupported(&input, type, kind);
+    confidence = MWAWDocument::isFileFormatSupported(&input, type, kind, prepared);
   }
   catch (...) {
     confidence = MWAWDocument::MWAW_C_NONE;
   }
-  if (confidence != MWAWDocument::MWAW_C_EXCELLENT) {
+  if (confidence != MWAWDocument::MWAW_C_EXCELLENT || !prepared) {
+    MWAWDocument::freePreparedDocument(prepared);
     printf("ERROR: Unsupported file format!\n");
     return 1;
   }
   if (type == MWAWDocument::MWAW_T_UNKNOWN) {
+    MWAWDocument::freePreparedDocument(prepared);
     printf("ERROR: can not determine the file type!\n");
     return 1;
   }
@@ -111,19 +115,19 @@ int main(int argc, char *argv[])
   try {
     if (kind == MWAWDocument::MWAW_K_DRAW || kind == MWAWDocument::MWAW_K_PAINT) {
       librevenge::RVNGRawDrawingGenerator documentGenerator(printIndentLevel);
-      error=MWAWDocument::parse(&input, &documentGenerator);
+      error=MWAWDocument::parse(prepared, &documentGenerator);
     }
     else if (kind == MWAWDocument::MWAW_K_SPREADSHEET || kind == MWAWDocument::MWAW_K_DATABASE) {
       librevenge::RVNGRawSpreadsheetGenerator documentGenerator(printIndentLevel);
-      error=MWAWDocument::parse(&input, &documentGenerator);
+      error=MWAWDocument::parse(prepared, &documentGenerator);
     }
     else if (kind == MWAWDocument::MWAW_K_PRESENTATION) {
       librevenge::RVNGRawPresentationGenerator documentGenerator(printIndentLevel);
-      error=MWAWDocument::parse(&input, &documentGenerator);
+      error=MWAWDocument::parse(prepared, &documentGenerator);
     }
     else {
       librevenge::RVNGRawTextGenerator documentGenerator(printIndentLevel);
-      error=MWAWDocument::parse(&input, &documentGenerator);
+      error=MWAWDocument::parse(prepared, &documentGenerator);
     }
   }
   catch (MWAWDocument::Result const &err) {
@@ -132,6 +136,7 @@ int main(int argc, char *argv[])
   catch (...) {
     error = MWAWDocument::MWAW_R_UNKNOWN_ERROR;
   }
+  MWAWDocument::freePreparedDocument(prepared);
 
   if (error == MWAWDocument::MWAW_R_FILE_ACCESS_ERROR)
     fprintf(stderr, "ERROR: File Exception!\n");
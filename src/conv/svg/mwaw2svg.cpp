@@ -114,22 +114,26 @@ int main(int argc, char *argv[])
     printUsage();
     return -1;
   }
-  librevenge::RVNGFileStream input(argv[optind]);
+  MWAWFileStream input(argv[optind]);
 
   MWAWDocument::Type type;
   MWAWDocument::Kind kind;
   MWAWDocument::Confidence confidence = MWAWDocument::MWAW_C_NONE;
+  // keep the detection result to avoid analysing the file twice
+  MWAWDocument::PreparedDocument *prepared=0;
   try {
-    confidence = MWAWDocument::isFileFormatSupported(&input, type, kind);
+    confidence = MWAWDocument::isFileFormatSupported(&input, type, kind, prepared);
   }
   catch (...) {
     confidence = MWAWDocument::MWAW_C_NONE;
   }
-  if (confidence != MWAWDocument::MWAW_C_EXCELLENT) {
+  if (confidence != MWAWDocument::MWAW_C_EXCELLENT || !prepared) {
+    MWAWDocument::freePreparedDocument(prepared);
     printf("ERROR: Unsupported file format!\n");
     return 1;
   }
   if (type == MWAWDocument::MWAW_T_UNKNOWN) {
+    MWAWDocument::freePreparedDocument(prepared);
     printf("ERROR: can not determine the type of file!\n");
     return 1;
   }
@@ -139,13 +143,14 @@ int main(int argc, char *argv[])
   try {
     if (kind == MWAWDocument::MWAW_K_DRAW || kind == MWAWDocument::MWAW_K_PAINT) {
       librevenge::RVNGSVGDrawingGenerator listener(vec, "");
-      error = MWAWDocument::parse(&input, &listener);
+      error = MWAWDocument::parse(prepared, &listener);
     }
     else if (kind == MWAWDocument::MWAW_K_PRESENTATION) {
       librevenge::RVNGSVGPresentationGenerator listener(vec);
-      error = MWAWDocument::parse(&input, &listener);
+      error = MWAWDocument::parse(prepared, &listener);
     }
     else {
+      MWAWDocument::freePreparedDocument(prepared);
       fprintf(stderr,"ERROR: not a graphic/presentation document!\n");
       return 1;
     }
@@ -158,6 +163,7 @@ int main(int argc, char *argv[])
   catch (...) {
     error=MWAWDocument::MWAW_R_UNKNOWN_ERROR;
   }
+  MWAWDocument::freePreparedDocument(prepared);
   if (error == MWAWDocument::MWAW_R_FILE_ACCESS_ERROR)
     fprintf(stderr, "ERROR: File Exception!\n");
   else if (error == MWAWDocument::MWAW_R_PARSE_ERROR)
@@ -99,23 +99,27 @@ int main(int argc, char *argv[])
     printUsage();
     return -1;
   }
-  librevenge::RVNGFileStream input(argv[optind]);
+  MWAWFileStream input(argv[optind]);
 
   MWAWDocument::Type type;
   MWAWDocument::Kind kind;
   MWAWDocument::Confidence confidence = MWAWDocument::MWAW_C_NONE;
+  // keep the detection result to avoid analysing the file twice
+  MWAWDocument::PreparedDocument *prepared=0;
   try {
-    MWAWDocument::isFileFormatSupported(&input, type, kind);
+    confidence = MWAWDocument::isFileFormatSupported(&input, type, kind, prepared);
   }
   catch (...) {
     confidence = MWAWDocument::MWAW_C_NONE;
   }
 
-  if (confidence != MWAWDocument::MWAW_C_EXCELLENT) {
+  if (confidence != MWAWDocument::MWAW_C_EXCELLENT || !prepared) {
+    MWAWDocument::freePreparedDocument(prepared);
     printf("ERROR: Unsupported file format!\n");
     return 1;
   }
   if (type == MWAWDocument::MWAW_T_UNKNOWN) {
+    MWAWDocument::freePreparedDocument(prepared);
     printf("ERROR: can not determine the type of file!\n");
     return 1;
   }
@@ -127,12 +131,14 @@ int main(int argc, char *argv[])
   try {
     if (kind == MWAWDocument::MWAW_K_DRAW || kind == MWAWDocument::MWAW_K_PAINT) {
       if (isInfo) {
+        MWAWDocument::freePreparedDocument(prepared);
         printf("ERROR: can not print info concerning a graphic document!\n");
         return 1;
       }
       librevenge::RVNGTextDrawingGenerator documentGenerator(pages);
-      error=MWAWDocument::parse(&input, &documentGenerator);
+      error=MWAWDocument::parse(prepared, &documentGenerator);
       if (error == MWAWDocument::MWAW_R_OK && !pages.size()) {
+        MWAWDocument::freePreparedDocument(prepared);
         printf("ERROR: find no graphics!\n");
         return 1;
       }
@@ -140,8 +146,9 @@ int main(int argc, char *argv[])
     }
     else if (kind == MWAWDocument::MWAW_K_SPREADSHEET || kind == MWAWDocument::MWAW_K_DATABASE) {
       librevenge::RVNGTextSpreadsheetGenerator documentGenerator(pages, isInfo);
-      error=MWAWDocument::parse(&input, &documentGenerator);
+      error=MWAWDocument::parse(prepared, &documentGenerator);
       if (error == MWAWDocument::MWAW_R_OK && !pages.size()) {
+        MWAWDocument::freePreparedDocument(prepared);
         printf("ERROR: find no sheets!\n");
         return 1;
       }
@@ -149,12 +156,14 @@ int main(int argc, char *argv[])
     }
     else if (kind == MWAWDocument::MWAW_K_PRESENTATION) {
       if (isInfo) {
+        MWAWDocument::freePreparedDocument(prepared);
         printf("ERROR: can not print info concerning a presentation document!\n");
         return 1;
       }
       librevenge::RVNGTextPresentationGenerator documentGenerator(pages);
-      error=MWAWDocument::parse(&input, &documentGenerator);
+      error=MWAWDocument::parse(prepared, &documentGenerator);
       if (error == MWAWDocument::MWAW_R_OK && !pages.size()) {
+        MWAWDocument::freePreparedDocument(prepared);
         printf("ERROR: find no slides!\n");
         return 1;
       }
@@ -162,7 +171,7 @@ int main(int argc, char *argv[])
     }
     else {
       librevenge::RVNGTextTextGenerator documentGenerator(document, isInfo);
-      error=MWAWDocument::parse(&input, &documentGenerator);
+      error=MWAWDocument::parse(prepared, &documentGenerator);
     }
   }
   catch (MWAWDocument::Result const &err) {
@@ -171,6 +180,7 @@ int main(int argc, char *argv[])
   catch (...) {
     error = MWAWDocument::MWAW_R_UNKNOWN_ERROR;
   }
+  MWAWDocument::freePreparedDocument(prepared);
 
   if (error == MWAWDocument::MWAW_R_FILE_ACCESS_ERROR)
     fprintf(stderr, "ERROR: File Exception!\n");
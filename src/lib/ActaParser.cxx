@@ -904,16 +904,10 @@ bool ActaParser::readOption(MWAWEntry const &entry)
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
-bool ActaParser::checkHeader(MWAWHeader *header, bool strict)
+bool ActaParser::probeHeader(MWAWInputStreamPtr &input, bool strict)
 {
-  *m_state = ActaParserInternal::State();
-  MWAWInputStreamPtr input = getInput();
-  if (!input || !input->hasDataFork() || !input->checkPosition(22))
+  if (!input || !input->checkPosition(22))
     return false;
-
-  libmwaw::DebugStream f;
-  f << "FileHeader:";
-
   // first check end of file
   input->seek(-4,librevenge::RVNG_SEEK_END);
   int last[2];
@@ -926,20 +920,14 @@ bool ActaParser::checkHeader(MWAWHeader *header, bool strict)
     vers=1;
   if (vers<=0)
     return false;
-  setVersion(vers);
 
   // ok, now check the beginning of the file
   int val;
   input->seek(0, librevenge::RVNG_SEEK_SET);
   if (vers==3) {
     val=(int) input->readULong(2);
-    if (val!=3) {
-      if (strict) return false;
-      if (val < 1 || val > 4)
-        return false;
-      f << "#vers=" << val << ",";
-      MWAW_DEBUG_MSG(("ActaParser::checkHeader: find unexpected version: %d\n", val));
-    }
+    if (val!=3 && (strict || val < 1 || val > 4))
+      return false;
   }
   val = (int) input->readULong(2); // depth ( first topic must have depth=1)
   if (val != 1)
@@ -951,9 +939,31 @@ bool ActaParser::checkHeader(MWAWHeader *header, bool strict)
   // check that the first text size is valid
   input->seek(vers==1 ? 18 : 20, librevenge::RVNG_SEEK_SET);
   long sz=(long) input->readULong(4);
-  if (!input->checkPosition(input->tell()+sz))
+  return input->checkPosition(input->tell()+sz);
+}
+
+bool ActaParser::checkHeader(MWAWHeader *header, bool strict)
+{
+  *m_state = ActaParserInternal::State();
+  MWAWInputStreamPtr input = getInput();
+  if (!input || !input->hasDataFork() || !probeHeader(input, strict))
     return false;
 
+  libmwaw::DebugStream f;
+  f << "FileHeader:";
+
+  input->seek(-4,librevenge::RVNG_SEEK_END);
+  int vers=input->readLong(2)==0x4E4C && input->readLong(2)==0x544F ? 3 : 1;
+  setVersion(vers);
+  if (vers==3) {
+    input->seek(0, librevenge::RVNG_SEEK_SET);
+    int val=(int) input->readULong(2);
+    if (val!=3) {
+      f << "#vers=" << val << ",";
+      MWAW_DEBUG_MSG(("ActaParser::checkHeader: find unexpected version: %d\n", val));
+    }
+  }
+
   if (header)
     header->reset(MWAWDocument::MWAW_T_ACTA, vers);
   if (vers >= 3) {
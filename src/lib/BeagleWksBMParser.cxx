@@ -439,6 +439,8 @@ bool BeagleWksBMParser::readBitmap()
     colors[1]=MWAWColor::black();
     pict->setColors(colors);
   }
+  libmwaw::PackBitsDecoder decoder;
+  std::vector<unsigned char> rowData(isColor ? size_t(bitmap.m_dim[0]) : size_t((bitmap.m_dim[0]+7)/8), 0);
   for (int r=0; r<bitmap.m_dim[1]; ++r) {
     pos=input->tell();
     int sz=(int) input->readULong(sSz);
@@ -452,47 +454,23 @@ bool BeagleWksBMParser::readBitmap()
       ascii().addNote(f.str().c_str());
       return false;
     }
-    int col=0;
-    while (input->tell()<rEndPos) {
-      int wh=(int) input->readULong(1);
-      if (wh>=0x81) {
-        int color=(int) input->readULong(1);
-        for (int j=0; j < 0x101-wh; ++j) {
-          if (col>=bitmap.m_dim[0]) break;
-          if (isColor) {
-            if (color>=numColors) break;
-            pict->set(col++, r, color);
-          }
-          else {
-            for (int b=7; b>=0; --b) {
-              if (col>=bitmap.m_dim[0]) break;
-              pict->set(col++, r, (color>>b)&1);
-            }
-          }
-        }
-      }
-      else {
-        for (int j=0; j < wh+1; ++j) {
-          int color=(int) input->readULong(1);
-          if (col>=bitmap.m_dim[0]) continue;
-          if (isColor) {
-            if (color>=numColors) break;
-            pict->set(col++, r, color);
-          }
-          else {
-            for (int b=7; b>=0; --b) {
-              if (col>=bitmap.m_dim[0]) break;
-              pict->set(col++, r, (color>>b)&1);
-            }
-          }
-        }
-      }
-      if (input->tell()>rEndPos) {
-        MWAW_DEBUG_MSG(("BeagleWksBMParser::readBitmap: can read row data %d\n", r));
-        f << "###";
-        ascii().addPos(pos);
-        ascii().addNote(f.str().c_str());
-        return false;
+    unsigned long numRead;
+    unsigned char const *data=input->read(size_t(sz), numRead);
+    if (!data || long(numRead)!=sz ||
+        !decoder.decode(data, numRead, &rowData[0], (unsigned long) rowData.size(), true, true)) {
+      MWAW_DEBUG_MSG(("BeagleWksBMParser::readBitmap: can read row data %d\n", r));
+      f << "###";
+      ascii().addPos(pos);
+      ascii().addNote(f.str().c_str());
+      return false;
+    }
+    int col=isColor ? int(decoder.getNumWritten()) : std::min(8*int(decoder.getNumWritten()), bitmap.m_dim[0]);
+    if (isColor) {
+      for (int c=0; c<col; ++c) {
+        if (rowData[size_t(c)]<numColors) continue;
+        // an unknown color, the end of the row is ignored
+        col=c;
+        break;
       }
     }
     if (col!=bitmap.m_dim[0]) {
@@ -502,6 +480,10 @@ bool BeagleWksBMParser::readBitmap()
       ascii().addNote(f.str().c_str());
       return false;
     }
+    if (isColor)
+      pict->setRow(r, &rowData[0]);
+    else
+      pict->setRowPacked(r, &rowData[0]);
     ascii().addPos(pos);
     ascii().addNote(f.str().c_str());
     input->seek(rEndPos, librevenge::RVNG_SEEK_SET);
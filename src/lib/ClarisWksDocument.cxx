@@ -492,7 +492,13 @@ bool ClarisWksDocument::createZones()
     ascFile.addNote(f.str().c_str());
   }
   // look for graphic
+  std::vector<std::string> graphicPatterns;
+  graphicPatterns.push_back("DSET");
+  graphicPatterns.push_back(std::string("\x11\x01", 2));
+  graphicPatterns.push_back(std::string("\x11\x02", 2));
   while (!input->isEnd()) {
+    if (!input->findNext(graphicPatterns))
+      break;
     long pos = input->tell();
     int val = (int) input->readULong(2);
     if (input->isEnd()) break;
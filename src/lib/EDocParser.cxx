@@ -32,6 +32,7 @@
 */
 
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -672,10 +673,10 @@ bool EDocParser::readInfo(MWAWEntry const &entry)
 // code to uncompress data ( very low level)
 namespace EDocParserInternal
 {
-//! very low structure to help uncompress data
+//! very low structure to help uncompress data: a dictionary coder followed by a run length coder
 struct DeflateStruct {
-  //! constructor
-  DeflateStruct(long size) : m_toWrite(size), m_data(size_t(size), 0), m_dataPos(0),
+  //! constructor given the final size and the final data
+  DeflateStruct(long size, librevenge::RVNGBinaryData &data) : m_toWrite(size), m_output(data), m_buffer(0x1000, 0), m_bufferPos(0),
     m_circQueue(0x2000,0), m_circQueuePos(0), m_numDelayed(0), m_delayedChar('\0')
   {
   }
@@ -685,42 +686,55 @@ struct DeflateStruct {
     return m_toWrite <= 0;
   }
   //! push a new character
-  bool push(unsigned char c)
+  void push(unsigned char c)
   {
-    if (m_toWrite <= 0) return false;
+    if (m_toWrite <= 0) return;
     m_circQueue[m_circQueuePos++]=c;
-    if (m_circQueuePos==0x2000)
-      m_circQueuePos=0;
-    if (m_numDelayed)
-      return treatDelayed(c);
-    if (c==0x81 && m_toWrite!=1) {
-      m_numDelayed++;
-      return true;
-    }
-    m_delayedChar=m_data[m_dataPos++]=c;
-    m_toWrite--;
-    return true;
+    m_circQueuePos &= 0x1FFF;
+    decode(&c, 1);
   }
   //! send a duplicated part of the data
-  bool sendDuplicated(int num, int depl);
+  void sendDuplicated(int num, int depl);
+  //! appends the remaining data to the final data
+  void flush()
+  {
+    if (!m_bufferPos) return;
+    m_output.append(&m_buffer[0], (unsigned long) m_bufferPos);
+    m_bufferPos=0;
+  }
+protected:
+  //! decodes the run length coding of some characters
+  void decode(unsigned char const *data, size_t num);
   //! check if there is delayed char, if so treat them
   bool treatDelayed(unsigned char c);
-  //! return the content of the block in dt
-  bool getBinaryData(librevenge::RVNGBinaryData &dt) const
+  //! writes some characters
+  void write(unsigned char const *data, size_t num)
   {
-    dt.clear();
-    if (m_dataPos==0) return false;
-    unsigned char const *firstPos=&m_data[0];
-    dt.append(firstPos, (unsigned long)m_dataPos);
-    return true;
+    if (m_bufferPos+num > m_buffer.size())
+      flush();
+    if (num >= m_buffer.size()) {
+      m_output.append(data, (unsigned long) num);
+      return;
+    }
+    memcpy(&m_buffer[m_bufferPos], data, num);
+    m_bufferPos+=num;
+  }
+  //! writes a character num times
+  void writeRepeated(unsigned char c, size_t num)
+  {
+    if (m_bufferPos+num > m_buffer.size())
+      flush();
+    memset(&m_buffer[m_bufferPos], c, num);
+    m_bufferPos+=num;
   }
-protected:
   //! the number of data that we need to write
   long m_toWrite;
   //! the resulting data
-  std::vector<unsigned char> m_data;
-  //! the actual pos in m_data
-  size_t m_dataPos;
+  librevenge::RVNGBinaryData &m_output;
+  //! a buffer used to store the decoded characters before appending them to m_output
+  std::vector<unsigned char> m_buffer;
+  //! the actual pos in m_buffer
+  size_t m_bufferPos;
 
   //! a circular queue
   std::vector<unsigned char> m_circQueue;
@@ -735,19 +749,56 @@ private:
   DeflateStruct &operator=(DeflateStruct const &orig);
 };
 
-bool DeflateStruct::sendDuplicated(int num, int depl)
+//! reads a big endian 16 bits value in buffer (returns 0 if the buffer is too short)
+static unsigned int readUInt16(unsigned char const *buffer, unsigned long bufferSize, unsigned long &pos)
+{
+  unsigned int res=pos+1<bufferSize ? ((unsigned int) buffer[pos]<<8)|(unsigned int) buffer[pos+1] : 0;
+  pos+=2;
+  return res;
+}
+
+void DeflateStruct::sendDuplicated(int num, int depl)
 {
-  int readPos=int(m_circQueuePos)+depl;
-  while (readPos < 0) readPos+=0x2000;
-  while (readPos >= 0x2000) readPos-=0x2000;
+  if (num <= 0 || m_toWrite <= 0) return;
+  size_t readPos=size_t(int(m_circQueuePos)+depl) & 0x1FFF;
+  unsigned char data[256];
+  if (num > 256) num=256;
+  // the two zones can overlap, so copy the characters one by one
+  for (int i=0; i<num; ++i) {
+    unsigned char c=m_circQueue[readPos];
+    readPos=(readPos+1) & 0x1FFF;
+    m_circQueue[m_circQueuePos]=data[i]=c;
+    m_circQueuePos=(m_circQueuePos+1) & 0x1FFF;
+  }
+  decode(data, size_t(num));
+}
 
-  while (num-->0) {
-    push(m_circQueue[size_t(readPos++)]);
-    if (readPos==0x2000)
-      readPos=0;
+void DeflateStruct::decode(unsigned char const *data, size_t num)
+{
+  size_t i=0;
+  while (i<num && m_toWrite > 0) {
+    unsigned char c=data[i];
+    if (m_numDelayed) {
+      treatDelayed(c);
+      ++i;
+      continue;
+    }
+    if (c==0x81 && m_toWrite!=1) {
+      m_numDelayed++;
+      ++i;
+      continue;
+    }
+    // find the next 0x81 and write all the characters before it
+    unsigned char const *next=(unsigned char const *) memchr(data+i+1, 0x81, num-i-1);
+    size_t len=next ? size_t(next-data)-i : num-i;
+    if (long(len) > m_toWrite) len=size_t(m_toWrite);
+    write(data+i, len);
+    m_delayedChar=data[i+len-1];
+    m_toWrite-=long(len);
+    i+=len;
   }
-  return true;
 }
+
 bool DeflateStruct::treatDelayed(unsigned char c)
 {
   if (m_toWrite <= 0)
@@ -757,27 +808,30 @@ bool DeflateStruct::treatDelayed(unsigned char c)
       m_numDelayed++;
       return true;
     }
-    m_delayedChar=m_data[m_dataPos++]=0x81;
+    m_delayedChar=0x81;
+    write(&m_delayedChar, 1);
     if (--m_toWrite==0) return true;
     if (c==0x81 && m_toWrite==1)
       return true;
     m_numDelayed=0;
-    m_delayedChar=m_data[m_dataPos++]=c;
+    m_delayedChar=c;
+    write(&c, 1);
     m_toWrite--;
     return true;
   }
 
   m_numDelayed=0;
   if (c==0) {
-    m_data[m_dataPos++]=0x81;
+    unsigned char const escape[]= {0x81, 0x82};
+    write(escape, 1);
     if (--m_toWrite==0) return true;
-    m_delayedChar=m_data[m_dataPos++]=0x82;
+    m_delayedChar=0x82;
+    write(escape+1, 1);
     m_toWrite--;
     return true;
   }
   if (c-1 > m_toWrite) return false;
-  for (int i = 0; i < int(c-1); i++)
-    m_data[m_dataPos++]=m_delayedChar;
+  writeRepeated(m_delayedChar, size_t(c-1));
   m_toWrite -= (c-1);
   return true;
 }
@@ -816,23 +870,32 @@ bool EDocParser::decodeZone(MWAWEntry const &entry, librevenge::RVNGBinaryData &
   ascFile.addPos(pos-4);
   ascFile.addNote(f.str().c_str());
 
-  EDocParserInternal::DeflateStruct deflate(zoneSize);
+  // read the data at once: the last code can use a few bytes after the end of the zone
+  long dataPos=input->tell();
+  unsigned long numRead=0;
+  unsigned char const *dataBuffer=input->read(size_t(endPos+6-dataPos), numRead);
+  if (!dataBuffer) numRead=0;
+  unsigned long rPos=0;
+
+  EDocParserInternal::DeflateStruct deflate(zoneSize, data);
   int const maxData[]= {0x80, 0x20, 0x40};
   int val;
 
-  while (!deflate.isEnd() && input->tell() < endPos-3) {
+  while (!deflate.isEnd() && dataPos+long(rPos) < endPos-3) {
     // only find a simple compress zone but seems ok to have more
     std::vector<unsigned char> vectors32K[3];
     std::vector<unsigned char> originalValues[3];
     for (int st=0; st < 3; st++) {
-      pos=input->tell();
+      pos=dataPos+long(rPos);
       f.str("");
       f << "CompressZone[data" << st << "]:";
-      int num=(int)input->readULong(1);
+      int num=rPos<numRead ? (int) dataBuffer[rPos] : 0;
+      ++rPos;
       f << "num=" << num << ",";
       if (num > maxData[st] || pos+1+num > endPos) {
         MWAW_DEBUG_MSG(("EDocParser::decodeZone: find unexpected num of data : %d for zone %d\n", num, st));
         f << "###";
+        data.clear();
 
         ascFile.addPos(pos);
         ascFile.addNote(f.str().c_str());
@@ -841,7 +904,7 @@ bool EDocParser::decodeZone(MWAWEntry const &entry, librevenge::RVNGBinaryData &
       std::multimap<int,int> mapData;
       originalValues[st].resize(size_t(maxData[st])*2, 0);
       for (int i = 0; i < num; i++) {
-        val=(int) input->readULong(1);
+        val=(int) dataBuffer[rPos++];
         for (int b=0; b < 2; b++) {
           int byte= b==0 ? (val>>4) : (val&0xF);
           originalValues[st][size_t(2*i+b)]=(unsigned char) byte;
@@ -859,24 +922,25 @@ bool EDocParser::decodeZone(MWAWEntry const &entry, librevenge::RVNGBinaryData &
           MWAW_DEBUG_MSG(("EDocParser::decodeZone: find unexpected value writePos=%x for zone %d\n",(unsigned int)(writePos+n), st));
 
           f << "###";
+          data.clear();
 
           ascFile.addPos(pos);
           ascFile.addNote(f.str().c_str());
           return false;
         }
-        for (int j = 0; j < n; j++)
-          vectors32K[st][size_t(writePos++)]=(unsigned char) it->second;
+        memset(&vectors32K[st][size_t(writePos)], it->second, size_t(n));
+        writePos+=n;
       }
 
       ascFile.addPos(pos);
       ascFile.addNote(f.str().c_str());
     }
-    pos = input->tell();
+    pos = dataPos+long(rPos);
     int byte=0;
     long maxBlockSz=0xFFF0;
-    unsigned int value=((unsigned int)input->readULong(2))<<16;
+    unsigned int value=EDocParserInternal::readUInt16(dataBuffer, numRead, rPos)<<16;
     while (maxBlockSz) {
-      if (deflate.isEnd() || input->tell()>endPos) break;
+      if (deflate.isEnd() || dataPos+long(rPos)>endPos) break;
       int ind0=(value>>16);
       if (ind0 & 0x8000) {
         int ind1 = (int) vectors32K[0][size_t(ind0&0x7FFF)];
@@ -884,7 +948,7 @@ bool EDocParser::decodeZone(MWAWEntry const &entry, librevenge::RVNGBinaryData &
         if (byte<byt1) {
           value = (value<<byte);
           byt1 -= byte;
-          value |= (unsigned int)input->readULong(2);
+          value |= EDocParserInternal::readUInt16(dataBuffer, numRead, rPos);
           byte=16;
         }
         value=(value<<byt1);
@@ -900,7 +964,7 @@ bool EDocParser::decodeZone(MWAWEntry const &entry, librevenge::RVNGBinaryData &
       if (byte<byt1) {
         value = (value<<byte);
         byt1 -= byte;
-        value |= (unsigned int)input->readULong(2);
+        value |= EDocParserInternal::readUInt16(dataBuffer, numRead, rPos);
         byte=16;
       }
       value=(value<<byt1);
@@ -910,7 +974,7 @@ bool EDocParser::decodeZone(MWAWEntry const &entry, librevenge::RVNGBinaryData &
       if (byte<byt2) {
         value = (value<<byte);
         byt2 -= byte;
-        value |= (unsigned int)input->readULong(2);
+        value |= EDocParserInternal::readUInt16(dataBuffer, numRead, rPos);
         byte=16;
       }
       value=(value<<byt2);
@@ -921,7 +985,7 @@ bool EDocParser::decodeZone(MWAWEntry const &entry, librevenge::RVNGBinaryData &
       if (byte<byt3) {
         value = (value<<byte);
         byt3 -= byte;
-        value |= (unsigned int)input->readULong(2);
+        value |= EDocParserInternal::readUInt16(dataBuffer, numRead, rPos);
         byte=16;
       }
       value=(value<<byt3);
@@ -930,13 +994,15 @@ bool EDocParser::decodeZone(MWAWEntry const &entry, librevenge::RVNGBinaryData &
       maxBlockSz-=3;
     }
   }
+  deflate.flush();
 
+  input->seek(dataPos+long(rPos < numRead ? rPos : numRead), librevenge::RVNG_SEEK_SET);
   if (input->tell()!=endPos) {
     MWAW_DEBUG_MSG(("EDocParser::decodeZone: unexpected end of data\n"));
     ascFile.addPos(input->tell());
     ascFile.addNote("CompressZone[after]");
   }
-  bool res = deflate.getBinaryData(data);
+  bool res = data.size()!=0;
   ascFile.skipZone(pos,input->tell()-1);
 #if defined(DEBUG_WITH_FILES)
   if (res) {
@@ -636,7 +636,22 @@ bool FullWrtParser::createZones()
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
-bool FullWrtParser::checkHeader(MWAWHeader *header, bool /*strict*/)
+bool FullWrtParser::probeHeader(MWAWInputStreamPtr &input, bool /*strict*/)
+{
+  if (!input || !input->checkPosition(50))
+    return false;
+  // check the two main zones, see readDocPosition
+  input->seek(-48+10, librevenge::RVNG_SEEK_END);
+  for (int i = 0; i < 2; i++) {
+    long begin=(long) input->readULong(4);
+    long length=(long) input->readULong(4);
+    if (begin<0 || length<=0 || !input->checkPosition(begin+length))
+      return false;
+  }
+  return true;
+}
+
+bool FullWrtParser::checkHeader(MWAWHeader *header, bool strict)
 {
   *m_state = FullWrtParserInternal::State();
 
@@ -644,10 +659,8 @@ bool FullWrtParser::checkHeader(MWAWHeader *header, bool /*strict*/)
   if (!input || !input->hasDataFork())
     return false;
 
-  int const minSize=50;
-  input->seek(minSize,librevenge::RVNG_SEEK_SET);
-  if (int(input->tell()) != minSize) {
-    MWAW_DEBUG_MSG(("FullWrtParser::checkHeader: file is too short\n"));
+  if (!probeHeader(input, strict)) {
+    MWAW_DEBUG_MSG(("FullWrtParser::checkHeader: the file header seems bad\n"));
     return false;
   }
 
@@ -935,120 +935,27 @@ bool HanMacWrdKParser::readZonec(shared_ptr<HanMacWrdKZone> zone)
 ////////////////////////////////////////////////////////////
 // code to uncompress a zone
 ////////////////////////////////////////////////////////////
-/* implementation of a basic splay tree to decode a block
-   freely inspired from: ftp://ftp.cs.uiowa.edu/pub/jones/compress/minunsplay.c :
-
-   Author: Douglas Jones, Dept. of Comp. Sci., U. of Iowa, Iowa City, IA 52242.
-   Date: Nov. 5, 1990.
-         (derived from the Feb. 14 1990 version by stripping out irrelevancies)
-         (minor revision of Feb. 20, 1989 to add exit(0) at end of program).
-         (minor revision of Nov. 14, 1988 to detect corrupt input better).
-         (minor revision of Aug. 8, 1988 to eliminate unused vars, fix -c).
-   Copyright:  This material is derived from code Copyrighted 1988 by
-         Jeffrey Chilton and Douglas Jones.  That code contained a copyright
-         notice allowing copying for personal or research purposes, so long
-         as copies of the code were not sold for direct commercial advantage.
-         This version of the code has been stripped of most of the material
-         added by Jeff Chilton, and this release of the code may be used or
-         copied for any purpose, public or private.
-   Patents:  The algorithm central to this code is entirely the invention of
-         Douglas Jones, and it has not been patented.  Any patents claiming
-         to cover this material are invalid.
-   Exportability:  Splay-tree based compression algorithms may be used for
-         cryptography, and when used as such, they may not be exported from
-         the United States without appropriate approval.  All cryptographic
-         features of the original version of this code have been removed.
-   Language: C
-   Purpose: Data uncompression program, a companion to minsplay.c
-   Algorithm: Uses a splay-tree based prefix code.  For a full understanding
-          of the operation of this data compression scheme, refer to the paper
-          "Applications of Splay Trees to Data Compression" by Douglas W. Jones
-          in Communications of the ACM, Aug. 1988, pages 996-1007.
-*/
+// the zones are compressed with a splay tree, see libmwaw::SplayTreeDecoder
 shared_ptr<HanMacWrdKZone> HanMacWrdKParser::decodeZone(shared_ptr<HanMacWrdKZone> zone)
 {
   if (!zone || zone->fileBeginPos()+12 >= zone->fileEndPos()) {
     MWAW_DEBUG_MSG(("HanMacWrdKParser::decodeZone: called with an invalid zone\n"));
     return zone;
   }
-  short const maxChar=256;
-  short const maxSucc=maxChar+1;
-  short const twoMaxChar=2*maxChar+1;
-  short const twoMaxSucc=2*maxSucc;
-
-  // first build the tree data
-  short left[maxSucc];
-  short right[maxSucc];
-  short up[twoMaxSucc];
-  for (short i = 0; i <= twoMaxChar; ++i)
-    up[i] = i/2;
-  for (short j = 0; j <= maxChar; ++j) {
-    left[j] = short(2 * j);
-    right[j] = short(2 * j + 1);
-  }
-
-  short const root = 0;
-  short const sizeBit = 8;
-  short const highBit=128; /* mask for the most sig bit of 8 bit byte */
-
-  short bitbuffer = 0;       /* buffer to hold a byte for unpacking bits */
-  short bitcounter = 0;  /* count of remaining bits in buffer */
-
+  // read the packed data at once, so that the decoding does not depend on the input stream
   MWAWInputStreamPtr input = getInput();
   input->seek(zone->fileBeginPos()+12, librevenge::RVNG_SEEK_SET);
+  unsigned long numRead=0;
+  unsigned char const *packedData=input->read(size_t(zone->fileEndPos()-(zone->fileBeginPos()+12)), numRead);
+  if (!packedData) numRead=0;
   librevenge::RVNGBinaryData &dt = zone->getBinaryData();
-  while (!input->isEnd() && input->tell() < zone->fileEndPos()) {
-    short a = root;
-    bool ok = true;
-    do {  /* once for each bit on path */
-      if (bitcounter == 0) {
-        if (input->isEnd() || input->tell() >= zone->fileEndPos()) {
-          MWAW_DEBUG_MSG(("HanMacWrdKParser::decodeZone: find some uncomplete data for zone%lx\n", (long unsigned int) zone->fileBeginPos()));
-          dt.append((unsigned char)a);
-          ok = false;
-          break;
-        }
-
-        bitbuffer = (short) input->readULong(1);
-        bitcounter = sizeBit;
-      }
-      --bitcounter;
-      if ((bitbuffer & highBit) != 0)
-        a = right[a];
-      else
-        a = left[a];
-      bitbuffer = short(bitbuffer << 1);
-    }
-    while (a <= maxChar);
-    if (!ok)
-      break;
-    dt.append((unsigned char)(a - maxSucc));
-
-    /* now splay tree about leaf a */
-    do {    /* walk up the tree semi-rotating pairs of nodes */
-      short c;
-      if ((c = up[a]) != root) {      /* a pair remains */
-        short d = up[c];
-        short b = left[d];
-        if (c == b) {
-          b = right[d];
-          right[d] = a;
-        }
-        else
-          left[d] = a;
-        if (left[c] == a)
-          left[c] = b;
-        else
-          right[c] = b;
-        up[a] = d;
-        up[b] = c;
-        a = d;
-      }
-      else
-        a = c;
-    }
-    while (a != root);
+  std::vector<unsigned char> data;
+  libmwaw::SplayTreeDecoder decoder;
+  if (!decoder.decode(packedData, numRead, data)) {
+    MWAW_DEBUG_MSG(("HanMacWrdKParser::decodeZone: find some uncomplete data for zone%lx\n", (long unsigned int) zone->fileBeginPos()));
   }
+  if (!data.empty())
+    dt.append(&data[0], (unsigned long) data.size());
   if (dt.size()==0) {
     MWAW_DEBUG_MSG(("HanMacWrdKParser::decodeZone: oops an empty zone\n"));
     zone.reset();
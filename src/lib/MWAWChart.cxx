@@ -171,7 +171,7 @@ void MWAWChart::add(MWAWChart::TextZone const &textZone)
   m_textZoneMap[textZone.m_type]=textZone;
 }
 
-void MWAWChart::sendChart(MWAWSpreadsheetListenerPtr &listener, librevenge::RVNGSpreadsheetInterface *interface)
+void MWAWChart::sendChart(MWAWSpreadsheetListenerPtr &listener, librevenge::RVNGSpreadsheetInterface *interface, MWAWPropertyListCache *cache)
 {
   if (!listener || !interface) {
     MWAW_DEBUG_MSG(("MWAWChart::sendChart: can not find listener or interface\n"));
@@ -203,7 +203,7 @@ void MWAWChart::sendChart(MWAWSpreadsheetListenerPtr &listener, librevenge::RVNG
   // legend
   if (m_legend.m_show && m_fontConverter) {
     style=librevenge::RVNGPropertyList();
-    m_legend.addStyleTo(style, m_fontConverter);
+    m_legend.addStyleTo(style, m_fontConverter, cache);
     style.insert("librevenge:chart-id", styleId);
     interface->defineChartStyle(style);
     librevenge::RVNGPropertyList legend;
@@ -219,7 +219,7 @@ void MWAWChart::sendChart(MWAWSpreadsheetListenerPtr &listener, librevenge::RVNG
     if (zone.m_type != TextZone::T_Title && zone.m_type != TextZone::T_SubTitle)
       continue;
     style=librevenge::RVNGPropertyList();
-    zone.addStyleTo(style, m_fontConverter);
+    zone.addStyleTo(style, m_fontConverter, cache);
     style.insert("librevenge:chart-id", styleId);
     interface->defineChartStyle(style);
     librevenge::RVNGPropertyList textZone;
@@ -280,7 +280,7 @@ void MWAWChart::sendChart(MWAWSpreadsheetListenerPtr &listener, librevenge::RVNG
   for (int i=0; i<3; ++i) {
     if (m_axis[i].m_type==Axis::A_None) continue;
     style=librevenge::RVNGPropertyList();
-    m_axis[i].addStyleTo(style);
+    m_axis[i].addStyleTo(style, cache);
     style.insert("librevenge:chart-id", styleId);
     interface->defineChartStyle(style);
     librevenge::RVNGPropertyList axis;
@@ -294,7 +294,7 @@ void MWAWChart::sendChart(MWAWSpreadsheetListenerPtr &listener, librevenge::RVNG
     if (zone.m_type == TextZone::T_Title || zone.m_type == TextZone::T_SubTitle)
       continue;
     style=librevenge::RVNGPropertyList();
-    zone.addStyleTo(style, m_fontConverter);
+    zone.addStyleTo(style, m_fontConverter, cache);
     style.insert("librevenge:chart-id", styleId);
     interface->defineChartStyle(style);
     librevenge::RVNGPropertyList textZone;
@@ -311,7 +311,7 @@ void MWAWChart::sendChart(MWAWSpreadsheetListenerPtr &listener, librevenge::RVNG
   // series
   for (size_t i=0; i < m_seriesList.size(); ++i) {
     style=librevenge::RVNGPropertyList();
-    m_seriesList[i].addStyleTo(style);
+    m_seriesList[i].addStyleTo(style, cache);
     style.insert("librevenge:chart-id", styleId);
     interface->defineChartStyle(style);
     librevenge::RVNGPropertyList series;
@@ -366,14 +366,14 @@ void MWAWChart::Axis::addContentTo(std::string const &sheetName, int coord, libr
   }
 }
 
-void MWAWChart::Axis::addStyleTo(librevenge::RVNGPropertyList &propList) const
+void MWAWChart::Axis::addStyleTo(librevenge::RVNGPropertyList &propList, MWAWPropertyListCache *cache) const
 {
   propList.insert("chart:display-label", m_showLabel);
   propList.insert("chart:axis-position", 0, librevenge::RVNG_GENERIC);
   propList.insert("chart:reverse-direction", false);
   propList.insert("chart:logarithmic", m_type==MWAWChart::Axis::A_Logarithmic);
   propList.insert("text:line-break", false);
-  m_style.addTo(propList, true);
+  m_style.addTo(propList, true, cache);
 }
 
 std::ostream &operator<<(std::ostream &o, MWAWChart::Axis const &axis)
@@ -430,11 +430,11 @@ void MWAWChart::Legend::addContentTo(librevenge::RVNGPropertyList &propList) con
   propList.insert("chart:legend-position", s.str().c_str());
 }
 
-void MWAWChart::Legend::addStyleTo(librevenge::RVNGPropertyList &propList, shared_ptr<MWAWFontConverter> fontConverter) const
+void MWAWChart::Legend::addStyleTo(librevenge::RVNGPropertyList &propList, shared_ptr<MWAWFontConverter> fontConverter, MWAWPropertyListCache *cache) const
 {
   propList.insert("chart:auto-position", m_autoPosition);
   m_font.addTo(propList, fontConverter);
-  m_style.addTo(propList);
+  m_style.addTo(propList, false, cache);
 }
 
 std::ostream &operator<<(std::ostream &o, MWAWChart::Legend const &legend)
@@ -520,9 +520,9 @@ void MWAWChart::Series::addContentTo(std::string const &sheetName, librevenge::R
   serie.insert("librevenge:childs", vect);
 }
 
-void MWAWChart::Series::addStyleTo(librevenge::RVNGPropertyList &propList) const
+void MWAWChart::Series::addStyleTo(librevenge::RVNGPropertyList &propList, MWAWPropertyListCache *cache) const
 {
-  m_style.addTo(propList);
+  m_style.addTo(propList, false, cache);
 }
 
 std::ostream &operator<<(std::ostream &o, MWAWChart::Series const &series)
@@ -606,10 +606,10 @@ void MWAWChart::TextZone::addContentTo(std::string const &sheetName, librevenge:
   }
 }
 
-void MWAWChart::TextZone::addStyleTo(librevenge::RVNGPropertyList &propList, shared_ptr<MWAWFontConverter> fontConverter) const
+void MWAWChart::TextZone::addStyleTo(librevenge::RVNGPropertyList &propList, shared_ptr<MWAWFontConverter> fontConverter, MWAWPropertyListCache *cache) const
 {
   m_font.addTo(propList, fontConverter);
-  m_style.addTo(propList);
+  m_style.addTo(propList, false, cache);
 }
 
 std::ostream &operator<<(std::ostream &o, MWAWChart::TextZone const &zone)
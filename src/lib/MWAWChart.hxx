@@ -70,7 +70,7 @@ public:
     //! add content to the propList
     void addContentTo(std::string const &sheetName, int coord, librevenge::RVNGPropertyList &propList) const;
     //! add style to the propList
-    void addStyleTo(librevenge::RVNGPropertyList &propList) const;
+    void addStyleTo(librevenge::RVNGPropertyList &propList, MWAWPropertyListCache *cache=0) const;
     //! operator<<
     friend std::ostream &operator<<(std::ostream &o, Axis const &axis);
     //! the sequence type
@@ -93,7 +93,7 @@ public:
     //! add content to the propList
     void addContentTo(librevenge::RVNGPropertyList &propList) const;
     //! add style to the propList
-    void addStyleTo(librevenge::RVNGPropertyList &propList, shared_ptr<MWAWFontConverter> fontConverter) const;
+    void addStyleTo(librevenge::RVNGPropertyList &propList, shared_ptr<MWAWFontConverter> fontConverter, MWAWPropertyListCache *cache=0) const;
     //! operator<<
     friend std::ostream &operator<<(std::ostream &o, Legend const &legend);
     //! show or not the legend
@@ -120,7 +120,7 @@ public:
     //! add content to the propList
     void addContentTo(std::string const &sheetName, librevenge::RVNGPropertyList &propList) const;
     //! add style to the propList
-    void addStyleTo(librevenge::RVNGPropertyList &propList) const;
+    void addStyleTo(librevenge::RVNGPropertyList &propList, MWAWPropertyListCache *cache=0) const;
     //! returns a string corresponding to a series type
     static std::string getSeriesTypeName(Type type);
     //! operator<<
@@ -146,7 +146,7 @@ public:
     //! add content to the propList
     void addContentTo(std::string const &sheetName, librevenge::RVNGPropertyList &propList) const;
     //! add to the propList
-    void addStyleTo(librevenge::RVNGPropertyList &propList, shared_ptr<MWAWFontConverter> fontConverter) const;
+    void addStyleTo(librevenge::RVNGPropertyList &propList, shared_ptr<MWAWFontConverter> fontConverter, MWAWPropertyListCache *cache=0) const;
     //! operator<<
     friend std::ostream &operator<<(std::ostream &o, TextZone const &zone);
     //! the zone type
@@ -169,8 +169,8 @@ public:
   MWAWChart(std::string const &sheetName, MWAWFontConverterPtr fontConverter, Vec2f const &dim=Vec2f());
   //! the destructor
   virtual ~MWAWChart();
-  //! send the chart to the listener
-  void sendChart(MWAWSpreadsheetListenerPtr &listener, librevenge::RVNGSpreadsheetInterface *interface);
+  //! send the chart to the listener (if set, cache is used to encode the patterns)
+  void sendChart(MWAWSpreadsheetListenerPtr &listener, librevenge::RVNGSpreadsheetInterface *interface, MWAWPropertyListCache *cache=0);
   //! send the zone content (called when the zone is of text type)
   virtual void sendContent(TextZone const &zone, MWAWListenerPtr &listener)=0;
 
@@ -74,6 +74,7 @@
 #include "MarinerWrtParser.hxx"
 #include "MindWrtParser.hxx"
 #include "MoreParser.hxx"
+#include "MsWksDocument.hxx"
 #include "MsWksParser.hxx"
 #include "MsWksDBParser.hxx"
 #include "MsWksDRParser.hxx"
@@ -97,138 +98,90 @@ shared_ptr<MWAWGraphicParser> getGraphicParserFromHeader(MWAWInputStreamPtr &inp
 shared_ptr<MWAWPresentationParser> getPresentationParserFromHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr rsrcParser, MWAWHeader *header);
 shared_ptr<MWAWSpreadsheetParser> getSpreadsheetParserFromHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr rsrcParser, MWAWHeader *header);
 shared_ptr<MWAWTextParser> getTextParserFromHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr rsrcParser, MWAWHeader *header);
-MWAWHeader *getHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr rsrcParser, bool strict);
-bool checkBasicMacHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr rsrcParser, MWAWHeader &header, bool strict);
+shared_ptr<MWAWHeader> getHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr rsrcParser, bool strict, shared_ptr<MWAWParser> &parser);
+bool checkBasicMacHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr rsrcParser, MWAWHeader &header, bool strict, shared_ptr<MWAWParser> &parser);
+MWAWDocument::Result prepare(librevenge::RVNGInputStream *input, bool strict, bool parseRSRC, MWAWDocument::PreparedDocument &prepared);
+MWAWDocument::Confidence analyze(librevenge::RVNGInputStream *input, MWAWDocument::Type &type, MWAWDocument::Kind &kind, MWAWDocument::PreparedDocument &prepared);
 }
 
-MWAWDocument::Confidence MWAWDocument::isFileFormatSupported(librevenge::RVNGInputStream *input,  MWAWDocument::Type &type, Kind &kind)
-try
+/** the structure used to store the result of a file analysis */
+class MWAWDocument::PreparedDocument
 {
-  type = MWAW_T_UNKNOWN;
-  kind = MWAW_K_UNKNOWN;
-
-  if (!input) {
-    MWAW_DEBUG_MSG(("MWAWDocument::isFileFormatSupported(): no input\n"));
-    return MWAW_C_NONE;
+public:
+  //! constructor
+  PreparedDocument() : m_input(), m_rsrcParser(), m_header(), m_parser()
+  {
   }
+  //! the decoded input
+  MWAWInputStreamPtr m_input;
+  //! the resource fork parser
+  MWAWRSRCParserPtr m_rsrcParser;
+  //! the document header
+  shared_ptr<MWAWHeader> m_header;
+  //! the parser used to check the header (reused by the first parse call)
+  shared_ptr<MWAWParser> m_parser;
+};
 
-  MWAWInputStreamPtr ip(new MWAWInputStream(input, false, true));
-  MWAWInputStreamPtr rsrc=ip->getResourceForkStream();
-  shared_ptr<MWAWRSRCParser> rsrcParser;
-  if (rsrc)
-    rsrcParser.reset(new MWAWRSRCParser(rsrc));
-  shared_ptr<MWAWHeader> header;
-#ifdef DEBUG
-  header.reset(MWAWDocumentInternal::getHeader(ip, rsrcParser, false));
-#else
-  header.reset(MWAWDocumentInternal::getHeader(ip, rsrcParser, true));
-#endif
-
-  if (!header.get())
-    return MWAW_C_NONE;
-  type = (MWAWDocument::Type)header->getType();
-  kind = (MWAWDocument::Kind)header->getKind();
-  Confidence confidence = MWAW_C_NONE;
+namespace MWAWDocumentInternal
+{
+/** returns the parser created when the header was checked if it has the
+    wanted type, or creates a new parser. holder stores the returned parser */
+template <class Parser>
+Parser *getParser(MWAWDocument::PreparedDocument &prepared, shared_ptr<MWAWParser> &holder,
+                  shared_ptr<Parser> (*createParser)(MWAWInputStreamPtr &, MWAWRSRCParserPtr, MWAWHeader *))
+{
+  holder=prepared.m_parser;
+  prepared.m_parser.reset();
+  Parser *parser=dynamic_cast<Parser *>(holder.get());
+  if (parser) return parser;
+  shared_ptr<Parser> newParser=createParser(prepared.m_input, prepared.m_rsrcParser, prepared.m_header.get());
+  holder=newParser;
+  return newParser.get();
+}
+}
 
-  switch (type) {
-  case MWAW_T_ACTA:
-  case MWAW_T_BEAGLEWORKS:
-  case MWAW_T_CLARISRESOLVE:
-  case MWAW_T_CLARISWORKS:
-  case MWAW_T_DOCMAKER:
-  case MWAW_T_EDOC:
-  case MWAW_T_FULLWRITE:
-  case MWAW_T_GREATWORKS:
-  case MWAW_T_HANMACWORDJ:
-  case MWAW_T_HANMACWORDK:
-  case MWAW_T_LIGHTWAYTEXT:
-  case MWAW_T_MACDOC:
-  case MWAW_T_MACDRAW:
-  case MWAW_T_MACDRAWPRO:
-  case MWAW_T_MACPAINT:
-  case MWAW_T_MACWRITE:
-  case MWAW_T_MACWRITEPRO:
-  case MWAW_T_MARINERWRITE:
-  case MWAW_T_MINDWRITE:
-  case MWAW_T_MORE:
-  case MWAW_T_MICROSOFTWORD:
-  case MWAW_T_MICROSOFTWORKS:
-  case MWAW_T_NISUSWRITER:
-  case MWAW_T_RAGTIME:
-  case MWAW_T_SUPERPAINT:
-  case MWAW_T_TEACHTEXT:
-  case MWAW_T_TEXEDIT:
-  case MWAW_T_WINGZ:
-  case MWAW_T_WRITENOW:
-  case MWAW_T_WRITERPLUS:
-  case MWAW_T_ZWRITE:
-    confidence = MWAW_C_EXCELLENT;
-    break;
-  case MWAW_T_ADOBEILLUSTRATOR:
-  case MWAW_T_DBASE:
-  case MWAW_T_FAMILYTREEMAKER:
-  case MWAW_T_FILEMAKER:
-  case MWAW_T_FOXBASE:
-  case MWAW_T_FRAMEMAKER:
-  case MWAW_T_FULLIMPACT:
-  case MWAW_T_FULLPAINT:
-  case MWAW_T_INFOGENIE:
-  case MWAW_T_KALEIDAGRAPH:
-  case MWAW_T_MACDRAFT:
-  case MWAW_T_MICROSOFTFILE:
-  case MWAW_T_MICROSOFTMULTIPLAN:
-  case MWAW_T_OVERVUE:
-  case MWAW_T_PAGEMAKER:
-  case MWAW_T_PIXELPAINT:
-  case MWAW_T_READYSETGO:
-  case MWAW_T_SYMPOSIUM:
-  case MWAW_T_TRAPEZE:
-  case MWAW_T_XPRESS:
-  case MWAW_T_4DIMENSION:
-
-  case MWAW_T_RESERVED1:
-  case MWAW_T_RESERVED2:
-  case MWAW_T_RESERVED3:
-  case MWAW_T_RESERVED4:
-  case MWAW_T_RESERVED5:
-  case MWAW_T_RESERVED6:
-  case MWAW_T_RESERVED7:
-  case MWAW_T_RESERVED8:
-  case MWAW_T_RESERVED9:
-  case MWAW_T_UNKNOWN:
-  default:
-    break;
-  }
+MWAWDocument::Confidence MWAWDocument::isFileFormatSupported(librevenge::RVNGInputStream *input,  MWAWDocument::Type &type, Kind &kind)
+{
+  PreparedDocument prepared;
+  return MWAWDocumentInternal::analyze(input, type, kind, prepared);
+}
 
+MWAWDocument::Confidence MWAWDocument::isFileFormatSupported(librevenge::RVNGInputStream *input,  MWAWDocument::Type &type, Kind &kind, PreparedDocument *&prepared)
+{
+  prepared=0;
+  PreparedDocument *res=new PreparedDocument;
+  Confidence confidence=MWAWDocumentInternal::analyze(input, type, kind, *res);
+  if (confidence==MWAW_C_EXCELLENT)
+    prepared=res;
+  else
+    delete res;
   return confidence;
 }
-catch (...)
+
+void MWAWDocument::freePreparedDocument(PreparedDocument *prepared)
 {
-  MWAW_DEBUG_MSG(("MWAWDocument::isFileFormatSupported: exception catched\n"));
-  type = MWAW_T_UNKNOWN;
-  kind = MWAW_K_UNKNOWN;
-  return MWAW_C_NONE;
+  if (prepared) delete prepared;
 }
 
-MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *)
-try
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password)
 {
   if (!input)
     return MWAW_R_UNKNOWN_ERROR;
 
-  MWAWInputStreamPtr ip(new MWAWInputStream(input, false, true));
-  MWAWInputStreamPtr rsrc=ip->getResourceForkStream();
-  shared_ptr<MWAWRSRCParser> rsrcParser;
-  if (rsrc) {
-    rsrcParser.reset(new MWAWRSRCParser(rsrc));
-    rsrcParser->setAsciiName("RSRC");
-    rsrcParser->parse();
-  }
-  shared_ptr<MWAWHeader> header(MWAWDocumentInternal::getHeader(ip, rsrcParser, false));
+  PreparedDocument prepared;
+  Result res=MWAWDocumentInternal::prepare(input, false, true, prepared);
+  if (res!=MWAW_R_OK) return res;
+  return parse(&prepared, documentInterface, password);
+}
 
-  if (!header.get()) return MWAW_R_UNKNOWN_ERROR;
+MWAWDocument::Result MWAWDocument::parse(PreparedDocument *prepared, librevenge::RVNGDrawingInterface *documentInterface, char const *)
+try
+{
+  if (!prepared || !prepared->m_header)
+    return MWAW_R_UNKNOWN_ERROR;
 
-  shared_ptr<MWAWGraphicParser> parser=MWAWDocumentInternal::getGraphicParserFromHeader(ip, rsrcParser, header.get());
+  shared_ptr<MWAWParser> holder;
+  MWAWGraphicParser *parser=MWAWDocumentInternal::getParser(*prepared, holder, MWAWDocumentInternal::getGraphicParserFromHeader);
   if (!parser) return MWAW_R_UNKNOWN_ERROR;
   parser->parse(documentInterface);
 
@@ -251,25 +204,25 @@ catch (...)
   return MWAW_R_UNKNOWN_ERROR;
 }
 
-MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *)
-try
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password)
 {
   if (!input)
     return MWAW_R_UNKNOWN_ERROR;
 
-  MWAWInputStreamPtr ip(new MWAWInputStream(input, false, true));
-  MWAWInputStreamPtr rsrc=ip->getResourceForkStream();
-  shared_ptr<MWAWRSRCParser> rsrcParser;
-  if (rsrc) {
-    rsrcParser.reset(new MWAWRSRCParser(rsrc));
-    rsrcParser->setAsciiName("RSRC");
-    rsrcParser->parse();
-  }
-  shared_ptr<MWAWHeader> header(MWAWDocumentInternal::getHeader(ip, rsrcParser, false));
+  PreparedDocument prepared;
+  Result res=MWAWDocumentInternal::prepare(input, false, true, prepared);
+  if (res!=MWAW_R_OK) return res;
+  return parse(&prepared, documentInterface, password);
+}
 
-  if (!header.get()) return MWAW_R_UNKNOWN_ERROR;
+MWAWDocument::Result MWAWDocument::parse(PreparedDocument *prepared, librevenge::RVNGPresentationInterface *documentInterface, char const *)
+try
+{
+  if (!prepared || !prepared->m_header)
+    return MWAW_R_UNKNOWN_ERROR;
 
-  shared_ptr<MWAWPresentationParser> parser=MWAWDocumentInternal::getPresentationParserFromHeader(ip, rsrcParser, header.get());
+  shared_ptr<MWAWParser> holder;
+  MWAWPresentationParser *parser=MWAWDocumentInternal::getParser(*prepared, holder, MWAWDocumentInternal::getPresentationParserFromHeader);
   if (!parser) return MWAW_R_UNKNOWN_ERROR;
   parser->parse(documentInterface);
 
@@ -292,25 +245,25 @@ catch (...)
   return MWAW_R_UNKNOWN_ERROR;
 }
 
-MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *)
-try
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password)
 {
   if (!input)
     return MWAW_R_UNKNOWN_ERROR;
 
-  MWAWInputStreamPtr ip(new MWAWInputStream(input, false, true));
-  MWAWInputStreamPtr rsrc=ip->getResourceForkStream();
-  shared_ptr<MWAWRSRCParser> rsrcParser;
-  if (rsrc) {
-    rsrcParser.reset(new MWAWRSRCParser(rsrc));
-    rsrcParser->setAsciiName("RSRC");
-    rsrcParser->parse();
-  }
-  shared_ptr<MWAWHeader> header(MWAWDocumentInternal::getHeader(ip, rsrcParser, false));
+  PreparedDocument prepared;
+  Result res=MWAWDocumentInternal::prepare(input, false, true, prepared);
+  if (res!=MWAW_R_OK) return res;
+  return parse(&prepared, documentInterface, password);
+}
 
-  if (!header.get()) return MWAW_R_UNKNOWN_ERROR;
+MWAWDocument::Result MWAWDocument::parse(PreparedDocument *prepared, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *)
+try
+{
+  if (!prepared || !prepared->m_header)
+    return MWAW_R_UNKNOWN_ERROR;
 
-  shared_ptr<MWAWSpreadsheetParser> parser=MWAWDocumentInternal::getSpreadsheetParserFromHeader(ip, rsrcParser, header.get());
+  shared_ptr<MWAWParser> holder;
+  MWAWSpreadsheetParser *parser=MWAWDocumentInternal::getParser(*prepared, holder, MWAWDocumentInternal::getSpreadsheetParserFromHeader);
   if (!parser) return MWAW_R_UNKNOWN_ERROR;
   parser->parse(documentInterface);
 
@@ -333,25 +286,25 @@ catch (...)
   return MWAW_R_UNKNOWN_ERROR;
 }
 
-MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const */*password*/)
-try
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password)
 {
   if (!input)
     return MWAW_R_UNKNOWN_ERROR;
 
-  MWAWInputStreamPtr ip(new MWAWInputStream(input, false, true));
-  MWAWInputStreamPtr rsrc=ip->getResourceForkStream();
-  shared_ptr<MWAWRSRCParser> rsrcParser;
-  if (rsrc) {
-    rsrcParser.reset(new MWAWRSRCParser(rsrc));
-    rsrcParser->setAsciiName("RSRC");
-    rsrcParser->parse();
-  }
-  shared_ptr<MWAWHeader> header(MWAWDocumentInternal::getHeader(ip, rsrcParser, false));
+  PreparedDocument prepared;
+  Result res=MWAWDocumentInternal::prepare(input, false, true, prepared);
+  if (res!=MWAW_R_OK) return res;
+  return parse(&prepared, documentInterface, password);
+}
 
-  if (!header.get()) return MWAW_R_UNKNOWN_ERROR;
+MWAWDocument::Result MWAWDocument::parse(PreparedDocument *prepared, librevenge::RVNGTextInterface *documentInterface, char const *)
+try
+{
+  if (!prepared || !prepared->m_header)
+    return MWAW_R_UNKNOWN_ERROR;
 
-  shared_ptr<MWAWTextParser> parser=MWAWDocumentInternal::getTextParserFromHeader(ip, rsrcParser, header.get());
+  shared_ptr<MWAWParser> holder;
+  MWAWTextParser *parser=MWAWDocumentInternal::getParser(*prepared, holder, MWAWDocumentInternal::getTextParserFromHeader);
   if (!parser) return MWAW_R_UNKNOWN_ERROR;
   parser->parse(documentInterface);
 
@@ -382,7 +335,7 @@ try
     return false;
   }
   MWAWGraphicDecoder tmpHandler(paintInterface);
-  if (!tmpHandler.checkData(binary) || !tmpHandler.readData(binary)) return false;
+  if (!tmpHandler.checkAndReadData(binary)) return false;
   return true;
 }
 catch (...)
@@ -399,7 +352,7 @@ try
     return false;
   }
   MWAWSpreadsheetDecoder tmpHandler(sheetInterface);
-  if (!tmpHandler.checkData(binary) || !tmpHandler.readData(binary)) return false;
+  if (!tmpHandler.checkAndReadData(binary)) return false;
   return true;
 }
 catch (...)
@@ -416,52 +369,183 @@ bool MWAWDocument::decodeText(librevenge::RVNGBinaryData const &, librevenge::RV
 
 namespace MWAWDocumentInternal
 {
-/** return the header corresponding to an input. Or 0L if no input are found */
-MWAWHeader *getHeader(MWAWInputStreamPtr &ip,
-                      MWAWRSRCParserPtr rsrcParser,
-                      bool strict)
+/** creates the input, the resource parser and finds the header.
+
+    \note if parseRSRC is set, the resource fork is parsed before looking for the header */
+MWAWDocument::Result prepare(librevenge::RVNGInputStream *input, bool strict, bool parseRSRC, MWAWDocument::PreparedDocument &prepared)
+try
+{
+  prepared.m_input.reset(new MWAWInputStream(input, false, true));
+  MWAWInputStreamPtr rsrc=prepared.m_input->getResourceForkStream();
+  if (rsrc) {
+    prepared.m_rsrcParser.reset(new MWAWRSRCParser(rsrc));
+    if (parseRSRC) {
+      prepared.m_rsrcParser->setAsciiName("RSRC");
+      prepared.m_rsrcParser->parse();
+    }
+  }
+  prepared.m_header=getHeader(prepared.m_input, prepared.m_rsrcParser, strict, prepared.m_parser);
+  if (!prepared.m_header) return MWAWDocument::MWAW_R_UNKNOWN_ERROR;
+  return MWAWDocument::MWAW_R_OK;
+}
+catch (libmwaw::FileException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocumentInternal::prepare: File exception trapped\n"));
+  return MWAWDocument::MWAW_R_FILE_ACCESS_ERROR;
+}
+catch (libmwaw::ParseException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocumentInternal::prepare: Parse exception trapped\n"));
+  return MWAWDocument::MWAW_R_PARSE_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  MWAW_DEBUG_MSG(("MWAWDocumentInternal::prepare: Unknown exception trapped\n"));
+  return MWAWDocument::MWAW_R_UNKNOWN_ERROR;
+}
+
+/** analyzes an input, fills prepared and returns the confidence */
+MWAWDocument::Confidence analyze(librevenge::RVNGInputStream *input, MWAWDocument::Type &type, MWAWDocument::Kind &kind, MWAWDocument::PreparedDocument &prepared)
+{
+  type = MWAWDocument::MWAW_T_UNKNOWN;
+  kind = MWAWDocument::MWAW_K_UNKNOWN;
+
+  if (!input) {
+    MWAW_DEBUG_MSG(("MWAWDocument::isFileFormatSupported(): no input\n"));
+    return MWAWDocument::MWAW_C_NONE;
+  }
+
+#ifdef DEBUG
+  bool strict=false;
+#else
+  bool strict=true;
+#endif
+  if (prepare(input, strict, false, prepared)!=MWAWDocument::MWAW_R_OK)
+    return MWAWDocument::MWAW_C_NONE;
+  type = (MWAWDocument::Type)prepared.m_header->getType();
+  kind = (MWAWDocument::Kind)prepared.m_header->getKind();
+
+  switch (type) {
+  case MWAWDocument::MWAW_T_ACTA:
+  case MWAWDocument::MWAW_T_BEAGLEWORKS:
+  case MWAWDocument::MWAW_T_CLARISRESOLVE:
+  case MWAWDocument::MWAW_T_CLARISWORKS:
+  case MWAWDocument::MWAW_T_DOCMAKER:
+  case MWAWDocument::MWAW_T_EDOC:
+  case MWAWDocument::MWAW_T_FULLWRITE:
+  case MWAWDocument::MWAW_T_GREATWORKS:
+  case MWAWDocument::MWAW_T_HANMACWORDJ:
+  case MWAWDocument::MWAW_T_HANMACWORDK:
+  case MWAWDocument::MWAW_T_LIGHTWAYTEXT:
+  case MWAWDocument::MWAW_T_MACDOC:
+  case MWAWDocument::MWAW_T_MACDRAW:
+  case MWAWDocument::MWAW_T_MACDRAWPRO:
+  case MWAWDocument::MWAW_T_MACPAINT:
+  case MWAWDocument::MWAW_T_MACWRITE:
+  case MWAWDocument::MWAW_T_MACWRITEPRO:
+  case MWAWDocument::MWAW_T_MARINERWRITE:
+  case MWAWDocument::MWAW_T_MINDWRITE:
+  case MWAWDocument::MWAW_T_MORE:
+  case MWAWDocument::MWAW_T_MICROSOFTWORD:
+  case MWAWDocument::MWAW_T_MICROSOFTWORKS:
+  case MWAWDocument::MWAW_T_NISUSWRITER:
+  case MWAWDocument::MWAW_T_RAGTIME:
+  case MWAWDocument::MWAW_T_SUPERPAINT:
+  case MWAWDocument::MWAW_T_TEACHTEXT:
+  case MWAWDocument::MWAW_T_TEXEDIT:
+  case MWAWDocument::MWAW_T_WINGZ:
+  case MWAWDocument::MWAW_T_WRITENOW:
+  case MWAWDocument::MWAW_T_WRITERPLUS:
+  case MWAWDocument::MWAW_T_ZWRITE:
+    return MWAWDocument::MWAW_C_EXCELLENT;
+  case MWAWDocument::MWAW_T_ADOBEILLUSTRATOR:
+  case MWAWDocument::MWAW_T_DBASE:
+  case MWAWDocument::MWAW_T_FAMILYTREEMAKER:
+  case MWAWDocument::MWAW_T_FILEMAKER:
+  case MWAWDocument::MWAW_T_FOXBASE:
+  case MWAWDocument::MWAW_T_FRAMEMAKER:
+  case MWAWDocument::MWAW_T_FULLIMPACT:
+  case MWAWDocument::MWAW_T_FULLPAINT:
+  case MWAWDocument::MWAW_T_INFOGENIE:
+  case MWAWDocument::MWAW_T_KALEIDAGRAPH:
+  case MWAWDocument::MWAW_T_MACDRAFT:
+  case MWAWDocument::MWAW_T_MICROSOFTFILE:
+  case MWAWDocument::MWAW_T_MICROSOFTMULTIPLAN:
+  case MWAWDocument::MWAW_T_OVERVUE:
+  case MWAWDocument::MWAW_T_PAGEMAKER:
+  case MWAWDocument::MWAW_T_PIXELPAINT:
+  case MWAWDocument::MWAW_T_READYSETGO:
+  case MWAWDocument::MWAW_T_SYMPOSIUM:
+  case MWAWDocument::MWAW_T_TRAPEZE:
+  case MWAWDocument::MWAW_T_XPRESS:
+  case MWAWDocument::MWAW_T_4DIMENSION:
+
+  case MWAWDocument::MWAW_T_RESERVED1:
+  case MWAWDocument::MWAW_T_RESERVED2:
+  case MWAWDocument::MWAW_T_RESERVED3:
+  case MWAWDocument::MWAW_T_RESERVED4:
+  case MWAWDocument::MWAW_T_RESERVED5:
+  case MWAWDocument::MWAW_T_RESERVED6:
+  case MWAWDocument::MWAW_T_RESERVED7:
+  case MWAWDocument::MWAW_T_RESERVED8:
+  case MWAWDocument::MWAW_T_RESERVED9:
+  case MWAWDocument::MWAW_T_UNKNOWN:
+  default:
+    break;
+  }
+
+  return MWAWDocument::MWAW_C_NONE;
+}
+
+/** return the header corresponding to an input and the parser used to check it. Or an empty header if no input are found */
+shared_ptr<MWAWHeader> getHeader(MWAWInputStreamPtr &ip,
+                                 MWAWRSRCParserPtr rsrcParser,
+                                 bool strict, shared_ptr<MWAWParser> &parser)
 try
 {
   std::vector<MWAWHeader> listHeaders;
 
-  if (!ip.get()) return 0L;
+  parser.reset();
+  if (!ip.get()) return shared_ptr<MWAWHeader>();
 
   if (ip->hasDataFork()) {
     /** avoid very short file */
-    if (!ip->hasResourceFork() && ip->size() < 10) return 0L;
+    if (!ip->hasResourceFork() && ip->size() < 10) return shared_ptr<MWAWHeader>();
 
     ip->seek(0, librevenge::RVNG_SEEK_SET);
     ip->setReadInverted(false);
   }
   else if (!ip->hasResourceFork())
-    return 0L;
+    return shared_ptr<MWAWHeader>();
 
   listHeaders = MWAWHeader::constructHeader(ip, rsrcParser);
   size_t numHeaders = listHeaders.size();
-  if (numHeaders==0) return 0L;
+  if (numHeaders==0) return shared_ptr<MWAWHeader>();
 
   for (size_t i = 0; i < numHeaders; i++) {
-    if (!MWAWDocumentInternal::checkBasicMacHeader(ip, rsrcParser, listHeaders[i], strict))
+    shared_ptr<MWAWHeader> header(new MWAWHeader(listHeaders[i]));
+    if (!MWAWDocumentInternal::checkBasicMacHeader(ip, rsrcParser, *header, strict, parser))
       continue;
-    return new MWAWHeader(listHeaders[i]);
+    return header;
   }
-  return 0L;
+  return shared_ptr<MWAWHeader>();
 }
 catch (libmwaw::FileException)
 {
   MWAW_DEBUG_MSG(("MWAWDocumentInternal::MWAWDocument[getHeader]:File exception trapped\n"));
-  return 0L;
+  return shared_ptr<MWAWHeader>();
 }
 catch (libmwaw::ParseException)
 {
   MWAW_DEBUG_MSG(("MWAWDocumentInternal::getHeader:Parse exception trapped\n"));
-  return 0L;
+  return shared_ptr<MWAWHeader>();
 }
 catch (...)
 {
   //fixme: too generic
   MWAW_DEBUG_MSG(("MWAWDocumentInternal::getHeader:Unknown exception trapped\n"));
-  return 0L;
+  return shared_ptr<MWAWHeader>();
 }
 
 shared_ptr<MWAWGraphicParser> getGraphicParserFromHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr rsrcParser, MWAWHeader *header)
@@ -904,24 +988,90 @@ shared_ptr<MWAWTextParser> getTextParserFromHeader(MWAWInputStreamPtr &input, MW
   return parser;
 }
 
-/** Wrapper to check a basic header of a mac file */
-bool checkBasicMacHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr rsrcParser, MWAWHeader &header, bool strict)
+////////////////////////////////////////////////////////////
+// header probes: stateless checks of the first bytes of a
+// file, used to reject a header without creating a parser
+////////////////////////////////////////////////////////////
+
+//! the function used to check quickly a header, see XXXParser::probeHeader
+typedef bool (*HeaderProbe)(MWAWInputStreamPtr &input, bool strict);
+
+//! a structure used to associate a probe to a file type
+struct HeaderProbeEntry {
+  //! the file type
+  MWAWDocument::Type m_type;
+  //! the probe
+  HeaderProbe m_probe;
+};
+
+/** the list of header probes.
+
+    \note only the types whose headers are created from weak signatures have a probe */
+static HeaderProbeEntry const s_headerProbes[]= {
+  { MWAWDocument::MWAW_T_ACTA, ActaParser::probeHeader },
+  { MWAWDocument::MWAW_T_FULLWRITE, FullWrtParser::probeHeader },
+  { MWAWDocument::MWAW_T_MACDRAW, MacDrawParser::probeHeader },
+  { MWAWDocument::MWAW_T_MACPAINT, MacPaintParser::probeHeader },
+  { MWAWDocument::MWAW_T_MACWRITE, MacWrtParser::probeHeader },
+  { MWAWDocument::MWAW_T_MACWRITEPRO, MacWrtProParser::probeHeader },
+  { MWAWDocument::MWAW_T_MICROSOFTWORKS, MsWksDocument::probeHeader },
+  { MWAWDocument::MWAW_T_MINDWRITE, MindWrtParser::probeHeader },
+  { MWAWDocument::MWAW_T_SUPERPAINT, SuperPaintParser::probeHeader },
+  { MWAWDocument::MWAW_T_WRITENOW, WriteNowParser::probeHeader },
+  { MWAWDocument::MWAW_T_WRITERPLUS, WriterPlsParser::probeHeader }
+};
+
+/** checks quickly if a header can be valid, ie. returns false if we
+    are sure that the parser's checkHeader will fail */
+static bool probeHeader(MWAWInputStreamPtr &input, MWAWHeader const &header, bool strict)
+{
+  if (!input->hasDataFork())
+    return true;
+  size_t const numProbes=sizeof(s_headerProbes)/sizeof(HeaderProbeEntry);
+  for (size_t i=0; i<numProbes; ++i) {
+    if (s_headerProbes[i].m_type!=header.getType())
+      continue;
+    bool ok=s_headerProbes[i].m_probe(input, strict);
+    input->seek(0, librevenge::RVNG_SEEK_SET);
+    return ok;
+  }
+  return true;
+}
+
+/** Wrapper to check a basic header of a mac file: first calls the
+    header probe, then creates the parser and calls its checkHeader function.
+
+    \note if the header is valid and if checkHeader does not change its
+    type, kind or version, parser is set to the created parser so that it can be
+    reused to parse the document */
+bool checkBasicMacHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr rsrcParser, MWAWHeader &header, bool strict, shared_ptr<MWAWParser> &parser)
 try
 {
-  shared_ptr<MWAWParser> parser=getTextParserFromHeader(input, rsrcParser, &header);
+  parser.reset();
+  if (!probeHeader(input, header, strict))
+    return false;
+  parser=getTextParserFromHeader(input, rsrcParser, &header);
   if (!parser)
     parser=getSpreadsheetParserFromHeader(input, rsrcParser, &header);
   if (!parser)
     parser=getGraphicParserFromHeader(input, rsrcParser, &header);
   if (!parser)
     parser=getPresentationParserFromHeader(input, rsrcParser, &header);
-  if (!parser)
+  MWAWHeader::Type const type=header.getType();
+  MWAWHeader::Kind const kind=header.getKind();
+  int const vers=header.getMajorVersion();
+  if (!parser || !parser->checkHeader(&header, strict)) {
+    parser.reset();
     return false;
-  return parser->checkHeader(&header, strict);
+  }
+  if (header.getType()!=type || header.getKind()!=kind || header.getMajorVersion()!=vers)
+    parser.reset();
+  return true;
 }
 catch (...)
 {
   MWAW_DEBUG_MSG(("MWAWDocumentInternal::checkBasicMacHeader:Unknown exception trapped\n"));
+  parser.reset();
   return false;
 }
 
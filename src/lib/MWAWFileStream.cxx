@@ -0,0 +1,241 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#include <stdio.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/types.h>
+#endif
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libmwaw/MWAWFileStream.hxx>
+
+#include "libmwaw_internal.hxx"
+
+//! internal data of a MWAWFileStream
+class MWAWFileStreamPrivate
+{
+public:
+  //! constructor
+  explicit MWAWFileStreamPrivate(char const *filename);
+  //! destructor
+  ~MWAWFileStreamPrivate();
+  //! returns the structured stream, creates it if needed
+  librevenge::RVNGInputStream *getStructuredStream();
+
+  //! the file name
+  std::string m_filename;
+  //! the file data: the mapping or the content of m_buffer
+  unsigned char const *m_data;
+  //! the file size
+  long m_size;
+  //! the stream offset
+  long m_offset;
+  //! a flag to know if m_data is a memory mapping
+  bool m_isMapped;
+  //! the file content, if the mapping failed
+  std::vector<unsigned char> m_buffer;
+  //! the file stream used to access to the structured's protocol
+  shared_ptr<librevenge::RVNGInputStream> m_structuredStream;
+private:
+  //! tries to map the file in memory
+  bool map();
+  //! reads the file content in m_buffer
+  bool load();
+
+  MWAWFileStreamPrivate(const MWAWFileStreamPrivate &);
+  MWAWFileStreamPrivate &operator=(const MWAWFileStreamPrivate &);
+};
+
+MWAWFileStreamPrivate::MWAWFileStreamPrivate(char const *filename) :
+  m_filename(filename ? filename : ""), m_data(0), m_size(0), m_offset(0), m_isMapped(false), m_buffer(), m_structuredStream()
+{
+  if (m_filename.empty()) return;
+  if (!map() && !load()) {
+    MWAW_DEBUG_MSG(("MWAWFileStreamPrivate::MWAWFileStreamPrivate: can not read file %s\n", filename));
+  }
+}
+
+MWAWFileStreamPrivate::~MWAWFileStreamPrivate()
+{
+#ifndef _WIN32
+  if (m_isMapped && m_data)
+    munmap(const_cast<unsigned char *>(m_data), size_t(m_size));
+#endif
+}
+
+bool MWAWFileStreamPrivate::map()
+{
+#ifndef _WIN32
+  int fd=open(m_filename.c_str(), O_RDONLY);
+  if (fd<0) return false;
+  struct stat status;
+  if (fstat(fd, &status)!=0 || !S_ISREG(status.st_mode) || status.st_size<=0 ||
+      status.st_size>(off_t) 0x7FFFFFFF) {
+    close(fd);
+    return false;
+  }
+  void *res=mmap(0, size_t(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (res==MAP_FAILED)
+    return false;
+  m_data=static_cast<unsigned char const *>(res);
+  m_size=long(status.st_size);
+  m_isMapped=true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool MWAWFileStreamPrivate::load()
+{
+  FILE *file=fopen(m_filename.c_str(), "rb");
+  if (!file) return false;
+  unsigned char buffer[4096];
+  while (true) {
+    size_t numRead=fread(buffer, 1, sizeof(buffer), file);
+    if (numRead==0) break;
+    m_buffer.insert(m_buffer.end(), buffer, buffer+numRead);
+  }
+  fclose(file);
+  m_size=long(m_buffer.size());
+  m_data=m_buffer.empty() ? 0 : &m_buffer[0];
+  return true;
+}
+
+librevenge::RVNGInputStream *MWAWFileStreamPrivate::getStructuredStream()
+{
+  if (!m_structuredStream && !m_filename.empty())
+    m_structuredStream.reset(new librevenge::RVNGFileStream(m_filename.c_str()));
+  return m_structuredStream.get();
+}
+
+MWAWFileStream::MWAWFileStream(const char *filename) :
+  librevenge::RVNGInputStream(),
+  m_data(new MWAWFileStreamPrivate(filename))
+{
+}
+
+MWAWFileStream::~MWAWFileStream()
+{
+  if (m_data) delete m_data;
+}
+
+bool MWAWFileStream::isMapped() const
+{
+  return m_data && m_data->m_isMapped;
+}
+
+const unsigned char *MWAWFileStream::read(unsigned long numBytes, unsigned long &numBytesRead)
+{
+  numBytesRead = 0;
+
+  if (numBytes == 0 || !m_data || !m_data->m_data || m_data->m_offset>=m_data->m_size)
+    return 0;
+
+  unsigned long numBytesToRead=(unsigned long)(m_data->m_size-m_data->m_offset);
+  if (numBytes<numBytesToRead)
+    numBytesToRead=numBytes;
+  numBytesRead=numBytesToRead;
+
+  long oldOffset = m_data->m_offset;
+  m_data->m_offset += long(numBytesToRead);
+  return m_data->m_data+oldOffset;
+}
+
+long MWAWFileStream::tell()
+{
+  return m_data ? m_data->m_offset : 0;
+}
+
+int MWAWFileStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
+{
+  if (!m_data) return -1;
+  if (seekType == librevenge::RVNG_SEEK_CUR)
+    offset += m_data->m_offset;
+  else if (seekType == librevenge::RVNG_SEEK_END)
+    offset += m_data->m_size;
+
+  if (offset < 0) {
+    m_data->m_offset = 0;
+    return -1;
+  }
+  if (offset > m_data->m_size) {
+    m_data->m_offset = m_data->m_size;
+    return -1;
+  }
+  m_data->m_offset = offset;
+  return 0;
+}
+
+bool MWAWFileStream::isEnd()
+{
+  return !m_data || m_data->m_offset >= m_data->m_size;
+}
+
+bool MWAWFileStream::isStructured()
+{
+  if (!m_data || !m_data->m_size) return false;
+  librevenge::RVNGInputStream *input=m_data->getStructuredStream();
+  return input && input->isStructured();
+}
+
+unsigned MWAWFileStream::subStreamCount()
+{
+  if (!isStructured()) return 0;
+  return m_data->getStructuredStream()->subStreamCount();
+}
+
+const char *MWAWFileStream::subStreamName(unsigned id)
+{
+  if (!isStructured()) return 0;
+  return m_data->getStructuredStream()->subStreamName(id);
+}
+
+bool MWAWFileStream::existsSubStream(const char *name)
+{
+  if (!isStructured()) return false;
+  return m_data->getStructuredStream()->existsSubStream(name);
+}
+
+librevenge::RVNGInputStream *MWAWFileStream::getSubStreamByName(const char *name)
+{
+  if (!isStructured()) return 0;
+  return m_data->getStructuredStream()->getSubStreamByName(name);
+}
+
+librevenge::RVNGInputStream *MWAWFileStream::getSubStreamById(unsigned id)
+{
+  if (!isStructured()) return 0;
+  return m_data->getStructuredStream()->getSubStreamById(id);
+}
+
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
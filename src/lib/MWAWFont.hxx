@@ -81,7 +81,7 @@ public:
       if (m_width < oth.m_width) return -1;
       if (m_width > oth.m_width) return 1;
       if (m_color.isSet() != oth.m_color.isSet())
-        return m_color.isSet();
+        return m_color.isSet() ? 1 : -1;
       if (m_color.get() < oth.m_color.get()) return -1;
       if (m_color.get() > oth.m_color.get()) return 1;
       return 0;
@@ -491,7 +491,7 @@ public:
     int diff = id() - oth.id();
     if (diff != 0) return diff;
     if (size() < oth.size()) return -1;
-    if (size() > oth.size()) return -1;
+    if (size() > oth.size()) return 1;
     if (flags() < oth.flags()) return -1;
     if (flags() > oth.flags()) return 1;
     if (m_deltaSpacing.get() < oth.m_deltaSpacing.get()) return -1;
@@ -510,6 +510,8 @@ public:
     if (m_color.get() > oth.m_color.get()) return 1;
     if (m_backgroundColor.get() < oth.m_backgroundColor.get()) return -1;
     if (m_backgroundColor.get() > oth.m_backgroundColor.get()) return 1;
+    if (m_language.isSet() != oth.m_language.isSet())
+      return m_language.isSet() ? 1 : -1;
     if (m_language.get() < oth.m_language.get()) return -1;
     if (m_language.get() > oth.m_language.get()) return 1;
     return diff;
@@ -45,20 +45,38 @@ namespace MWAWFontConverterInternal
 //! Internal and low level: tools to convert Macintosh characters
 namespace Data
 {
+//! Internal and low level: a table to convert the 256 characters in unicode
+struct ConversionTable {
+  //! constructor: no character is converted
+  ConversionTable()
+  {
+    for (int i = 0; i < 256; i++)
+      m_unicode[i]=-1;
+  }
+  //! Internal and Low level: adds a vector of \a numElt elements (char, unicode)
+  void add(int const *arr, size_t numElt)
+  {
+    for (size_t i = 0; i < numElt; i++)
+      m_unicode[(unsigned char)arr[2*i]] = arr[2*i+1];
+  }
+  //! the unicode character corresponding to each character or -1
+  int m_unicode[256];
+};
+
 //! Internal and low level: a class to store a conversion map for character, ...
 struct ConversionData {
   //! constructor
-  ConversionData(std::map<unsigned char, unsigned long> &map,
+  ConversionData(ConversionTable const &table,
                  char const *odtName="", int delta=0)
-    : m_encoding(MWAWFontConverter::E_DEFAULT), m_conversion(map), m_name(odtName), m_deltaSize(delta) {}
+    : m_encoding(MWAWFontConverter::E_DEFAULT), m_conversion(table), m_name(odtName), m_deltaSize(delta) {}
   //! constructor for different encoding
-  ConversionData(std::map<unsigned char, unsigned long> &map, MWAWFontConverter::Encoding encoding, char const *odtName="", int delta=0)
-    : m_encoding(encoding), m_conversion(map), m_name(odtName), m_deltaSize(delta) {}
+  ConversionData(ConversionTable const &table, MWAWFontConverter::Encoding encoding, char const *odtName="", int delta=0)
+    : m_encoding(encoding), m_conversion(table), m_name(odtName), m_deltaSize(delta) {}
 
   //! the character encoding
   MWAWFontConverter::Encoding m_encoding;
-  //! the conversion map character -> unicode
-  std::map<unsigned char, unsigned long> &m_conversion;
+  //! the conversion table character -> unicode
+  ConversionTable const &m_conversion;
   //! the odt font name (if empty used the name)
   std::string m_name;
   //! the size delta: odtSize = fSize + deltaSize
@@ -409,6 +427,9 @@ static int const s_SJISSimplifiedUnicode[]= {
   0xD9,0xFF99, 0xDA,0xFF9A, 0xDB,0xFF9B, 0xDC,0xFF9C, 0xDD,0xFF9D, 0xDE,0xFF9E, 0xDF,0xFF9F
 };
 
+/** the known conversions: the conversion tables and the font family map.
+
+    \note this class is only created once and shared by all the converters */
 class KnownConversion
 {
 public:
@@ -428,15 +449,11 @@ public:
   {
     initMaps();
   }
-  //! returns the conversion map which corresponds to a name, or the default map
-  Data::ConversionData const &getConversionMaps(std::string fName);
+  /** returns the conversion map which corresponds to a name, or the default map.
+
+      \note familyMap contains the family defined by the document, they are used in priority */
+  Data::ConversionData const &getConversionMaps(std::string fName, std::map<std::string, std::string> const &familyMap) const;
 
-  //! set a family correspondance
-  void setFamily(std::string const &fName, std::string const &family)
-  {
-    if (fName.length() && family.length())
-      m_familyMap[fName]=family;
-  }
   //! return the default converter
   ConversionData const &getDefault() const
   {
@@ -446,51 +463,41 @@ protected:
   //! Internal and Low level: initializes all the conversion maps
   void initMaps();
 
-  //! Internal and Low level: initializes a map with a vector of \a numElt elements (char, unicode)
-  static void initAMap(int const *arr, size_t numElt, std::map<unsigned char, unsigned long> &map)
-  {
-    for (size_t i = 0; i < numElt; i++) {
-      unsigned char c = (unsigned char)arr[2*i];
-      unsigned long unicode = (unsigned long)arr[2*i+1];
-      map[c] = unicode;
-    }
-  }
-
   /** the conversiont map fName -> ConversionData */
   std::map<std::string, ConversionData const *> m_convertMap;
 
   //! Internal and Low level: map font name -> family font name
   std::map<std::string, std::string> m_familyMap;
 
-  //! Internal and Low level: map char -> unicode for roman font
-  std::map<unsigned char, unsigned long> m_romanMap;
-  //! Internal and Low level: map char -> unicode for central european font
-  std::map<unsigned char, unsigned long> m_centralEuroMap;
-  //! Internal and Low level: map char -> unicode for cyrillic font
-  std::map<unsigned char, unsigned long> m_cyrillicMap;
-  //! Internal and Low level: map char -> unicode for turkish font
-  std::map<unsigned char, unsigned long> m_turkishMap;
-
-  //! Internal and Low level: map char -> unicode for symbol font
-  std::map<unsigned char, unsigned long> m_symbolMap;
-  //! Internal and Low level: map char -> unicode for dingbats font
-  std::map<unsigned char, unsigned long> m_dingbatsMap;
-  //! Internal and Low level: map char -> unicode for cursive font
-  std::map<unsigned char, unsigned long> m_cursiveMap;
-  //! Internal and Low level: map char -> unicode for math font
-  std::map<unsigned char, unsigned long> m_mathMap;
-  //! Internal and Low level: map char -> unicode for scientific font
-  std::map<unsigned char, unsigned long> m_scientificMap;
-  //! Internal and Low level: map char -> unicode for wingdings font
-  std::map<unsigned char, unsigned long> m_wingdingsMap;
-  //! Internal and Low level: simplified map char -> unicode for SJIS font
-  std::map<unsigned char, unsigned long> m_SJISMap;
-  //! Internal and Low level: map char -> unicode for font 107
-  std::map<unsigned char, unsigned long> m_unknown107Map;
-  //! Internal and Low level: map char -> unicode for font 128
-  std::map<unsigned char, unsigned long> m_unknown128Map;
-  //! Internal and Low level: map char -> unicode for font 200
-  std::map<unsigned char, unsigned long> m_unknown200Map;
+  //! Internal and Low level: table char -> unicode for roman font
+  ConversionTable m_romanMap;
+  //! Internal and Low level: table char -> unicode for central european font
+  ConversionTable m_centralEuroMap;
+  //! Internal and Low level: table char -> unicode for cyrillic font
+  ConversionTable m_cyrillicMap;
+  //! Internal and Low level: table char -> unicode for turkish font
+  ConversionTable m_turkishMap;
+
+  //! Internal and Low level: table char -> unicode for symbol font
+  ConversionTable m_symbolMap;
+  //! Internal and Low level: table char -> unicode for dingbats font
+  ConversionTable m_dingbatsMap;
+  //! Internal and Low level: table char -> unicode for cursive font
+  ConversionTable m_cursiveMap;
+  //! Internal and Low level: table char -> unicode for math font
+  ConversionTable m_mathMap;
+  //! Internal and Low level: table char -> unicode for scientific font
+  ConversionTable m_scientificMap;
+  //! Internal and Low level: table char -> unicode for wingdings font
+  ConversionTable m_wingdingsMap;
+  //! Internal and Low level: simplified table char -> unicode for SJIS font
+  ConversionTable m_SJISMap;
+  //! Internal and Low level: table char -> unicode for font 107
+  ConversionTable m_unknown107Map;
+  //! Internal and Low level: table char -> unicode for font 128
+  ConversionTable m_unknown128Map;
+  //! Internal and Low level: table char -> unicode for font 200
+  ConversionTable m_unknown200Map;
 
   //! Internal and Low level: the default converter: roman
   ConversionData m_defaultConv;
@@ -525,6 +532,9 @@ protected:
   ConversionData m_unknown128Conv;
   //! Internal and Low level: the converter for font 200
   ConversionData m_unknown200Conv;
+private:
+  KnownConversion(KnownConversion const &orig);
+  KnownConversion &operator=(KnownConversion const &orig);
 };
 
 
@@ -532,27 +542,23 @@ protected:
 void KnownConversion::initMaps()
 {
   size_t numRoman = sizeof(s_romanUnicode)/(2*sizeof(int));
-  for (size_t i = 0; i < numRoman; i++) {
-    unsigned char c = (unsigned char)s_romanUnicode[2*i];
-    unsigned long unicode = (unsigned long)s_romanUnicode[2*i+1];
-    m_romanMap[c] = m_turkishMap[c] = unicode;
-    m_cursiveMap[c] = m_mathMap[c] = m_scientificMap[c] = unicode;
-    m_unknown107Map[c] = m_unknown128Map[c] = m_unknown200Map[c] = unicode;
-  }
-  initAMap(s_centralEuroUnicode, sizeof(s_centralEuroUnicode)/(2*sizeof(int)), m_centralEuroMap);
-  initAMap(s_cyrillicUnicode, sizeof(s_cyrillicUnicode)/(2*sizeof(int)), m_cyrillicMap);
-  initAMap(s_turkishUnicode, sizeof(s_turkishUnicode)/(2*sizeof(int)), m_turkishMap);
-
-  initAMap(s_symbolUnicode, sizeof(s_symbolUnicode)/(2*sizeof(int)), m_symbolMap);
-  initAMap(s_dingbatsUnicode, sizeof(s_dingbatsUnicode)/(2*sizeof(int)), m_dingbatsMap);
-  initAMap(s_cursiveIncompleteUnicode, sizeof(s_cursiveIncompleteUnicode)/(2*sizeof(int)), m_cursiveMap);
-  initAMap(s_mathIncompleteUnicode, sizeof(s_mathIncompleteUnicode)/(2*sizeof(int)), m_mathMap);
-  initAMap(s_scientificIncompleteUnicode, sizeof(s_scientificIncompleteUnicode)/(2*sizeof(int)),m_scientificMap);
-  initAMap(s_wingdingsUnicode, sizeof(s_wingdingsUnicode)/(2*sizeof(int)), m_wingdingsMap);
-  initAMap(s_SJISSimplifiedUnicode, sizeof(s_SJISSimplifiedUnicode)/(2*sizeof(int)), m_SJISMap);
-  initAMap(s_unknown107IncompleteUnicode, sizeof(s_unknown107IncompleteUnicode)/(2*sizeof(int)),m_unknown107Map);
-  initAMap(s_unknown128IncompleteUnicode, sizeof(s_unknown128IncompleteUnicode)/(2*sizeof(int)),m_unknown128Map);
-  initAMap(s_unknown200IncompleteUnicode, sizeof(s_unknown200IncompleteUnicode)/(2*sizeof(int)),m_unknown200Map);
+  m_romanMap.add(s_romanUnicode, numRoman);
+  m_turkishMap = m_cursiveMap = m_mathMap = m_scientificMap = m_romanMap;
+  m_unknown107Map = m_unknown128Map = m_unknown200Map = m_romanMap;
+  m_centralEuroMap.add(s_centralEuroUnicode, sizeof(s_centralEuroUnicode)/(2*sizeof(int)));
+  m_cyrillicMap.add(s_cyrillicUnicode, sizeof(s_cyrillicUnicode)/(2*sizeof(int)));
+  m_turkishMap.add(s_turkishUnicode, sizeof(s_turkishUnicode)/(2*sizeof(int)));
+
+  m_symbolMap.add(s_symbolUnicode, sizeof(s_symbolUnicode)/(2*sizeof(int)));
+  m_dingbatsMap.add(s_dingbatsUnicode, sizeof(s_dingbatsUnicode)/(2*sizeof(int)));
+  m_cursiveMap.add(s_cursiveIncompleteUnicode, sizeof(s_cursiveIncompleteUnicode)/(2*sizeof(int)));
+  m_mathMap.add(s_mathIncompleteUnicode, sizeof(s_mathIncompleteUnicode)/(2*sizeof(int)));
+  m_scientificMap.add(s_scientificIncompleteUnicode, sizeof(s_scientificIncompleteUnicode)/(2*sizeof(int)));
+  m_wingdingsMap.add(s_wingdingsUnicode, sizeof(s_wingdingsUnicode)/(2*sizeof(int)));
+  m_SJISMap.add(s_SJISSimplifiedUnicode, sizeof(s_SJISSimplifiedUnicode)/(2*sizeof(int)));
+  m_unknown107Map.add(s_unknown107IncompleteUnicode, sizeof(s_unknown107IncompleteUnicode)/(2*sizeof(int)));
+  m_unknown128Map.add(s_unknown128IncompleteUnicode, sizeof(s_unknown128IncompleteUnicode)/(2*sizeof(int)));
+  m_unknown200Map.add(s_unknown200IncompleteUnicode, sizeof(s_unknown200IncompleteUnicode)/(2*sizeof(int)));
 
   // init convertMap
   m_convertMap[std::string("Default")] = &m_defaultConv;
@@ -586,28 +592,31 @@ void KnownConversion::initMaps()
   m_familyMap["Hiragino San GB W6"]="Osaka"; // checkme
 }
 
-ConversionData const &KnownConversion::getConversionMaps(std::string fName)
+ConversionData const &KnownConversion::getConversionMaps(std::string fName, std::map<std::string, std::string> const &familyMap) const
 {
   if (fName.empty()) return m_defaultConv;
-  std::map<std::string, ConversionData const *>::iterator it= m_convertMap.find(fName);
+  std::map<std::string, ConversionData const *>::const_iterator it= m_convertMap.find(fName);
   if (it != m_convertMap.end()) return *(it->second);
 
   // look for a family map
-  std::map<std::string, std::string>::iterator famIt= m_familyMap.find(fName);
-  if (famIt == m_familyMap.end()) {
-    // checkme maybe ok for pre-OS7, ... but not for WorldScript
-    size_t len=fName.length();
-    if (len > 4 && fName.substr(len-4,4)==" CYR")
-      return m_cyrillicConv;
-    if (len > 3 && fName[len-3]==' ') {
-      if (fName.substr(len-3,3)==" CE")
-        return m_centralEuroConv;
-      if (fName.substr(len-3,3)==" CY")
+  std::map<std::string, std::string>::const_iterator famIt= familyMap.find(fName);
+  if (famIt == familyMap.end()) {
+    famIt=m_familyMap.find(fName);
+    if (famIt == m_familyMap.end()) {
+      // checkme maybe ok for pre-OS7, ... but not for WorldScript
+      size_t len=fName.length();
+      if (len > 4 && fName.substr(len-4,4)==" CYR")
         return m_cyrillicConv;
-      if (fName.substr(len-3,3)==" TC")
-        return m_turkishConv;
+      if (len > 3 && fName[len-3]==' ') {
+        if (fName.substr(len-3,3)==" CE")
+          return m_centralEuroConv;
+        if (fName.substr(len-3,3)==" CY")
+          return m_cyrillicConv;
+        if (fName.substr(len-3,3)==" TC")
+          return m_turkishConv;
+      }
+      return m_defaultConv;
     }
-    return m_defaultConv;
   }
   fName = famIt->second;
   it= m_convertMap.find(fName);
@@ -615,28 +624,52 @@ ConversionData const &KnownConversion::getConversionMaps(std::string fName)
   return  m_defaultConv;
 }
 
+//! Internal and low level: the map between the system font id and the font name
+struct FontNameIndex {
+  //! constructor
+  FontNameIndex() : m_idNameMap(), m_nameIdMap()
+  {
+    initMaps();
+  }
+  //! initializes the map
+  void initMaps();
+  //! map sysid -> font name
+  std::map<int, std::string> m_idNameMap;
+  //! map font name -> sysid
+  std::map<std::string, int> m_nameIdMap;
+};
+
+//! the known conversions, created when the library is loaded
+static KnownConversion const s_knownConversion;
+
 }
 
+//! the default font names, created when the library is loaded
+static Data::FontNameIndex const s_fontNameIndex;
+
 //------------------------------------------------------------
 //
 // Font convertor imlementation
 //
 //------------------------------------------------------------
-//! the default font converter
+/** the default font converter.
+
+    \note the conversion tables and the default font names are shared,
+    this class only stores the correspondances defined by the document */
 class State
 {
 public:
   //! the constructor
-  State() : m_knownConversion(), m_idNameMap(), m_nameIdMap(),
+  State() : m_familyMap(), m_idNameMap(), m_nameIdMap(),
     m_nameIdCounter(0), m_uniqueId(768), m_sjisConverter(), m_unicodeCache()
   {
-    initMaps();
   }
 
   /** returns an unused id */
   int getUnusedId()
   {
-    while (m_idNameMap.find(m_uniqueId)!=m_idNameMap.end())
+    while (m_idNameMap.find(m_uniqueId)!=m_idNameMap.end() ||
+           s_fontNameIndex.m_idNameMap.find(m_uniqueId)!=s_fontNameIndex.m_idNameMap.end())
       m_uniqueId++;
     return m_uniqueId;
   }
@@ -646,8 +679,10 @@ public:
   int getId(std::string const &name, std::string family="")
   {
     if (name.empty()) return -1;
-    std::map<std::string,int>::iterator it=m_nameIdMap.find(name);
+    std::map<std::string,int>::const_iterator it=m_nameIdMap.find(name);
     if (it != m_nameIdMap.end()) return it->second;
+    it=s_fontNameIndex.m_nameIdMap.find(name);
+    if (it != s_fontNameIndex.m_nameIdMap.end()) return it->second;
     int newId=getUnusedId();
     setCorrespondance(newId, name, family);
     return newId;
@@ -656,8 +691,10 @@ public:
   //! returns the name corresponding to an id or return std::string("")
   std::string getName(int macId)
   {
-    std::map<int, std::string>::iterator it=m_idNameMap.find(macId);
-    if (it==m_idNameMap.end()) return "";
+    std::map<int, std::string>::const_iterator it=m_idNameMap.find(macId);
+    if (it!=m_idNameMap.end()) return it->second;
+    it=s_fontNameIndex.m_idNameMap.find(macId);
+    if (it==s_fontNameIndex.m_idNameMap.end()) return "";
     return it->second;
   }
 
@@ -671,6 +708,10 @@ public:
   /** converts a character in unicode, if needed can read the next input caracter in str
       \return -1 if the character is not transformed */
   int unicode(int macId, unsigned char c, unsigned char const *(&str), int len);
+  /** converts a run of characters in unicode and appends the utf8 result to buffer
+
+      \return the number of characters used */
+  size_t unicode(int macId, unsigned char const *str, size_t len, librevenge::RVNGString &buffer);
   /** final font name and a delta which can be used to change the size
   if no name is found, return "Times New Roman" */
   void getOdtInfo(int macId, std::string &nm, int &deltaSize);
@@ -681,21 +722,19 @@ public:
     m_idNameMap[macId] = name;
     m_nameIdMap[name] = macId;
     m_nameIdCounter++;
-    if (family.length())
-      m_knownConversion.setFamily(name,family);
+    if (name.length() && family.length())
+      m_familyMap[name]=family;
   }
 
 protected:
-  //! initializes the map
-  void initMaps();
   //! try to update the cache
   bool updateCache(int macId);
 
-  //! the basic conversion map
-  MWAWFontConverterInternal::Data::KnownConversion m_knownConversion;
-  //! map sysid -> font name
+  //! map font name -> family font name defined by the document
+  std::map<std::string, std::string> m_familyMap;
+  //! map sysid -> font name defined by the document
   std::map<int, std::string> m_idNameMap;
-  //! map font name -> sysid
+  //! map font name -> sysid defined by the document
   std::map<std::string, int> m_nameIdMap;
 
   //!Internal: a counter modified when a new correspondance name<->id is found
@@ -721,8 +760,8 @@ protected:
 
 };
 
-// initializes the default conversion map
-void State::initMaps()
+// initializes the default font names
+void Data::FontNameIndex::initMaps()
 {
   // see http://developer.apple.com/documentation/mac/Text/Text-277.html
   // or Apple II Technical Notes #41 (  http://www.umich.edu/~archive/apple2/technotes/tn/iigs/TN.IIGS.041 )
@@ -834,7 +873,7 @@ bool State::updateCache(int macId)
   if (!m_unicodeCache.m_conv || m_unicodeCache.m_macId != macId ||  m_unicodeCache.m_nameIdCounter != m_nameIdCounter) {
     m_unicodeCache.m_macId = macId;
     m_unicodeCache.m_nameIdCounter = m_nameIdCounter;
-    m_unicodeCache.m_conv = &m_knownConversion.getConversionMaps(getName(macId));
+    m_unicodeCache.m_conv = &Data::s_knownConversion.getConversionMaps(getName(macId), m_familyMap);
   }
   if (!m_unicodeCache.m_conv) {
     MWAW_DEBUG_MSG(("unicode Error: can not find a convertor\n"));
@@ -848,10 +887,7 @@ int State::unicode(int macId, unsigned char c)
 {
   if (!updateCache(macId))
     return -1;
-  std::map<unsigned char, unsigned long>::const_iterator it = m_unicodeCache.m_conv->m_conversion.find(c);
-
-  if (it == m_unicodeCache.m_conv->m_conversion.end()) return -1;
-  return (int) it->second;
+  return m_unicodeCache.m_conv->m_conversion.m_unicode[c];
 }
 
 // returns an unicode caracter
@@ -865,9 +901,7 @@ int State::unicode(int macId, unsigned char c, MWAWInputStreamPtr &input)
     return m_sjisConverter->unicode(c,input);
   }
 
-  std::map<unsigned char, unsigned long>::const_iterator it = m_unicodeCache.m_conv->m_conversion.find(c);
-  if (it == m_unicodeCache.m_conv->m_conversion.end()) return -1;
-  return (int) it->second;
+  return m_unicodeCache.m_conv->m_conversion.m_unicode[c];
 }
 
 int State::unicode(int macId, unsigned char c, unsigned char const *(&str), int len)
@@ -880,15 +914,34 @@ int State::unicode(int macId, unsigned char c, unsigned char const *(&str), int
     return m_sjisConverter->unicode(c,str,len);
   }
 
-  std::map<unsigned char, unsigned long>::const_iterator it = m_unicodeCache.m_conv->m_conversion.find(c);
-  if (it == m_unicodeCache.m_conv->m_conversion.end()) return -1;
-  return (int) it->second;
+  return m_unicodeCache.m_conv->m_conversion.m_unicode[c];
+}
+
+size_t State::unicode(int macId, unsigned char const *str, size_t len, librevenge::RVNGString &buffer)
+{
+  int const *table=updateCache(macId) ? m_unicodeCache.m_conv->m_conversion.m_unicode : 0;
+  bool isSJIS=table && m_unicodeCache.m_conv->m_encoding==MWAWFontConverter::E_SJIS;
+  if (isSJIS) {
+    if (!m_sjisConverter)
+      m_sjisConverter.reset(new MWAWFontSJISConverter);
+    return m_sjisConverter->unicode(str, len, buffer);
+  }
+  libmwaw::UTF8Appender utf8(buffer);
+  size_t i=0;
+  for (; i < len; ++i) {
+    unsigned char c=str[i];
+    if (c < 0x20) continue;
+    int val=table ? table[c] : -1;
+    if (val == -1) val=int(c);
+    utf8.append(uint32_t(val));
+  }
+  return i;
 }
 
 void State::getOdtInfo(int macId, std::string &nm, int &deltaSize)
 {
   std::string nam = getName(macId);
-  MWAWFontConverterInternal::Data::ConversionData const *conv = &m_knownConversion.getConversionMaps(nam);
+  MWAWFontConverterInternal::Data::ConversionData const *conv = &Data::s_knownConversion.getConversionMaps(nam, m_familyMap);
 
   nm = conv->m_name;
   deltaSize = conv->m_deltaSize;
@@ -970,4 +1023,10 @@ int MWAWFontConverter::unicode(int macId, unsigned char c, unsigned char const *
   if (c < 0x20) return -1;
   return m_manager->unicode(macId,c,str,len);
 }
+
+size_t MWAWFontConverter::unicode(int macId, unsigned char const *str, size_t len, librevenge::RVNGString &buffer) const
+{
+  if (!str || !len) return 0;
+  return m_manager->unicode(macId,str,len,buffer);
+}
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
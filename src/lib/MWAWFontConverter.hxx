@@ -97,6 +97,13 @@ public:
   /** converts a character in unicode, if needed can read the next input caracter in str
      \return -1 if the character is not transformed */
   int unicode(int macId, unsigned char c, unsigned char const *(&str), int len) const;
+  /** converts a run of characters in unicode and appends the utf8 result to buffer.
+     The characters which are not transformed are appended as latin1 characters,
+     the control characters are skipped.
+
+     \return the number of characters used, ie. len excepted if the last
+     character needs a following character to be converted */
+  size_t unicode(int macId, unsigned char const *str, size_t len, librevenge::RVNGString &buffer) const;
 protected:
   /** check if a string is valid, if not, convert it to a valid string */
   static std::string getValidName(std::string const &name);
@@ -1496,55 +1496,134 @@ static uint32_t const s_SJIS_encoding2[]= {
 * instead of those above.
 */
 
+/** Internal: the structures of a MWAWFontSJISConverter */
+namespace MWAWFontSJISConverterInternal
+{
+//! returns true if c is the first byte of a two bytes character
+static bool isLeadByte(unsigned char c)
+{
+  return (c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC);
+}
+
+/** Internal: a two-level table sjis->unicode, shared by all the converters
+
+    \note the first level is indexed by the first byte, the second by the
+    trailing byte, the unknown characters are associated to -1 */
+struct Table {
+  //! constructor: creates the table from s_SJIS_encoding and s_SJIS_encoding2
+  Table() : m_values(), m_blockIds()
+  {
+    // block 0 contains the single byte characters, then one block by lead byte
+    int numBlocks=1;
+    for (int c=0; c<256; ++c)
+      m_blockIds[c]=isLeadByte((unsigned char) c) ? numBlocks++ : 0;
+    m_values.resize(size_t(numBlocks)*256, -1);
+    size_t numData=sizeof(libmwaw::s_SJIS_encoding)/sizeof(uint32_t);
+    for (size_t i = 0; i+1 < numData; i+=2)
+      set(libmwaw::s_SJIS_encoding[i], int(libmwaw::s_SJIS_encoding[i+1]));
+    // fixme do differently
+    numData=sizeof(libmwaw::s_SJIS_encoding2)/sizeof(uint32_t);
+    for (size_t i = 0; i+2 < numData; i+=3)
+      set(libmwaw::s_SJIS_encoding2[i], int(libmwaw::s_SJIS_encoding2[i+1]));
+  }
+  //! returns the unicode corresponding to a single byte character
+  int get(unsigned char c) const
+  {
+    return m_values[size_t(c)];
+  }
+  //! returns the unicode corresponding to a two bytes character
+  int get(unsigned char c, unsigned char c1) const
+  {
+    return m_values[size_t(m_blockIds[c])*256+size_t(c1)];
+  }
+  //! returns the global table
+  static Table const &getTable()
+  {
+    static Table const s_table;
+    return s_table;
+  }
+protected:
+  //! sets a value
+  void set(uint32_t sjisChar, int unicode)
+  {
+    if (sjisChar<0x100) {
+      if (!isLeadByte((unsigned char) sjisChar))
+        m_values[size_t(sjisChar)]=unicode;
+      return;
+    }
+    unsigned char c=(unsigned char)(sjisChar>>8);
+    if (sjisChar>=0x10000 || !isLeadByte(c)) {
+      MWAW_DEBUG_MSG(("MWAWFontSJISConverterInternal::Table::set: unexpected character %x\n", (unsigned int) sjisChar));
+      return;
+    }
+    m_values[size_t(m_blockIds[c])*256+(sjisChar&0xFF)]=unicode;
+  }
+  //! the unicode values
+  std::vector<int> m_values;
+  //! the block corresponding to each first byte
+  int m_blockIds[256];
+};
+}
+
 ////////////////////////////////////////////////////////////
 // MWAWFontSJISConverter code
 ////////////////////////////////////////////////////////////
-MWAWFontSJISConverter::MWAWFontSJISConverter() : m_sjisUnicodeMap()
+MWAWFontSJISConverter::MWAWFontSJISConverter()
 {
-  initMap();
+  // creates the table now
+  MWAWFontSJISConverterInternal::Table::getTable();
 }
 
 MWAWFontSJISConverter::~MWAWFontSJISConverter()
 {
 }
 
-void MWAWFontSJISConverter::initMap()
-{
-  size_t numData=sizeof(libmwaw::s_SJIS_encoding)/sizeof(uint32_t);
-  for (size_t i = 0; i+1 < numData; i+=2)
-    m_sjisUnicodeMap[int(libmwaw::s_SJIS_encoding[i])]=int(libmwaw::s_SJIS_encoding[i+1]);
-  // fixme do differently
-  numData=sizeof(libmwaw::s_SJIS_encoding2)/sizeof(uint32_t);
-  for (size_t i = 0; i+2 < numData; i+=3)
-    m_sjisUnicodeMap[int(libmwaw::s_SJIS_encoding2[i])]=int(libmwaw::s_SJIS_encoding2[i+1]);
-}
-
 int MWAWFontSJISConverter::unicode(unsigned char c, MWAWInputStreamPtr &input)
 {
-  uint32_t sjisChar = uint32_t(c);
+  MWAWFontSJISConverterInternal::Table const &table=MWAWFontSJISConverterInternal::Table::getTable();
+  if (!MWAWFontSJISConverterInternal::isLeadByte(c))
+    return table.get(c);
+  if (input->isEnd()) return -1;
   long pos = input->tell();
-  if ((c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC)) {
-    if (input->isEnd()) return -1;
-    sjisChar = (sjisChar<<8)+uint32_t(input->readULong(1));
-  }
-  if (m_sjisUnicodeMap.find(int(sjisChar))!=m_sjisUnicodeMap.end())
-    return m_sjisUnicodeMap.find(int(sjisChar))->second;
-  input->seek(pos, librevenge::RVNG_SEEK_SET);
-  return -1;
+  int val=table.get(c, (unsigned char) input->readULong(1));
+  if (val==-1)
+    input->seek(pos, librevenge::RVNG_SEEK_SET);
+  return val;
 }
 
 int  MWAWFontSJISConverter::unicode(unsigned char c, unsigned char const *(&str), int len)
 {
-  uint32_t sjisChar = uint32_t(c);
-  unsigned char const *pos=str;
-  if ((c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC)) {
-    if (len <= 0) return -1;
-    sjisChar = (sjisChar<<8)+uint32_t(*(str++));
+  MWAWFontSJISConverterInternal::Table const &table=MWAWFontSJISConverterInternal::Table::getTable();
+  if (!MWAWFontSJISConverterInternal::isLeadByte(c))
+    return table.get(c);
+  if (len <= 0) return -1;
+  int val=table.get(c, *str);
+  if (val!=-1)
+    ++str;
+  return val;
+}
+
+size_t MWAWFontSJISConverter::unicode(unsigned char const *str, size_t len, librevenge::RVNGString &buffer)
+{
+  MWAWFontSJISConverterInternal::Table const &table=MWAWFontSJISConverterInternal::Table::getTable();
+  libmwaw::UTF8Appender utf8(buffer);
+  size_t i=0;
+  for (; i < len; ++i) {
+    unsigned char c=str[i];
+    if (c < 0x20) continue;
+    int val;
+    if (!MWAWFontSJISConverterInternal::isLeadByte(c))
+      val=table.get(c);
+    else if (i+1==len)
+      break; // we need the next character
+    else {
+      val=table.get(c, str[i+1]);
+      if (val!=-1) ++i;
+    }
+    if (val == -1) val=int(c);
+    utf8.append(uint32_t(val));
   }
-  if (m_sjisUnicodeMap.find(int(sjisChar))!=m_sjisUnicodeMap.end())
-    return m_sjisUnicodeMap.find(int(sjisChar))->second;
-  str=pos;
-  return -1;
+  return i;
 }
 
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
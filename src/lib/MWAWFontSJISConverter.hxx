@@ -38,8 +38,6 @@
 #ifndef MWAW_FONT_SJIS_CONVERTER
 #  define MWAW_FONT_SJIS_CONVERTER
 
-#include <map>
-
 #include "libmwaw_internal.hxx"
 
 /*! \brief a namespace used to convert Mac SJIS font characters in unicode
@@ -56,11 +54,11 @@ public:
   int unicode(unsigned char c, MWAWInputStreamPtr &input);
   //! try to return a unicode for a shift jis character ( returns -1 if the character can not be converted )
   int unicode(unsigned char c, unsigned char const *(&str), int len);
-  //!init the mapping
-  void initMap();
-protected:
-  //! a map sjis->unicode
-  std::map<int,int> m_sjisUnicodeMap;
+  /** converts a run of shift jis characters and appends the utf8 result to buffer
+      (see MWAWFontConverter::unicode)
+
+      \return the number of characters used */
+  size_t unicode(unsigned char const *str, size_t len, librevenge::RVNGString &buffer);
 };
 
 #endif
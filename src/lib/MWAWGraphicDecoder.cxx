@@ -44,215 +44,303 @@
 
 #include "MWAWGraphicDecoder.hxx"
 
+//! Internal: the structures of a MWAWGraphicDecoder
+namespace MWAWGraphicDecoderInternal
+{
+//! the different elements (sorted by name)
+enum ElementId {
+  E_CloseGroup,
+  E_CloseLink,
+  E_CloseListElement,
+  E_CloseOrderedListLevel,
+  E_CloseParagraph,
+  E_CloseSpan,
+  E_CloseTableCell,
+  E_CloseTableRow,
+  E_CloseUnorderedListLevel,
+  E_DefineCharacterStyle,
+  E_DefineEmbeddedFont,
+  E_DefineParagraphStyle,
+  E_DrawConnector,
+  E_DrawEllipse,
+  E_DrawGraphicObject,
+  E_DrawPath,
+  E_DrawPolygon,
+  E_DrawPolyline,
+  E_DrawRectangle,
+  E_EndDocument,
+  E_EndEmbeddedGraphics,
+  E_EndLayer,
+  E_EndMasterPage,
+  E_EndPage,
+  E_EndTableObject,
+  E_EndTextObject,
+  E_InsertCoveredTableCell,
+  E_InsertField,
+  E_InsertLineBreak,
+  E_InsertSpace,
+  E_InsertTab,
+  E_OpenGroup,
+  E_OpenLink,
+  E_OpenListElement,
+  E_OpenOrderedListLevel,
+  E_OpenParagraph,
+  E_OpenSpan,
+  E_OpenTableCell,
+  E_OpenTableRow,
+  E_OpenUnorderedListLevel,
+  E_SetDocumentMetaData,
+  E_SetStyle,
+  E_StartDocument,
+  E_StartEmbeddedGraphics,
+  E_StartLayer,
+  E_StartMasterPage,
+  E_StartPage,
+  E_StartTableObject,
+  E_StartTextObject
+};
+//! the element names (sorted by name)
+static char const *const s_elementNames[]= {
+  "CloseGroup",
+  "CloseLink",
+  "CloseListElement",
+  "CloseOrderedListLevel",
+  "CloseParagraph",
+  "CloseSpan",
+  "CloseTableCell",
+  "CloseTableRow",
+  "CloseUnorderedListLevel",
+  "DefineCharacterStyle",
+  "DefineEmbeddedFont",
+  "DefineParagraphStyle",
+  "DrawConnector",
+  "DrawEllipse",
+  "DrawGraphicObject",
+  "DrawPath",
+  "DrawPolygon",
+  "DrawPolyline",
+  "DrawRectangle",
+  "EndDocument",
+  "EndEmbeddedGraphics",
+  "EndLayer",
+  "EndMasterPage",
+  "EndPage",
+  "EndTableObject",
+  "EndTextObject",
+  "InsertCoveredTableCell",
+  "InsertField",
+  "InsertLineBreak",
+  "InsertSpace",
+  "InsertTab",
+  "OpenGroup",
+  "OpenLink",
+  "OpenListElement",
+  "OpenOrderedListLevel",
+  "OpenParagraph",
+  "OpenSpan",
+  "OpenTableCell",
+  "OpenTableRow",
+  "OpenUnorderedListLevel",
+  "SetDocumentMetaData",
+  "SetStyle",
+  "StartDocument",
+  "StartEmbeddedGraphics",
+  "StartLayer",
+  "StartMasterPage",
+  "StartPage",
+  "StartTableObject",
+  "StartTextObject"
+};
+}
+
+int MWAWGraphicDecoder::getElementId(const char *psName) const
+{
+  return findElementId(psName, MWAWGraphicDecoderInternal::s_elementNames, int(sizeof(MWAWGraphicDecoderInternal::s_elementNames)/sizeof(char const *)));
+}
+
 void MWAWGraphicDecoder::insertElement(const char *psName)
 {
-  if (!m_output) return;
-  int len=psName ? int(strlen(psName)) : 0;
-  if (!len) {
-    MWAW_DEBUG_MSG(("MWAWGraphicDecoder::insertElement: called without name\n"));
+  if (!psName || !*psName) {
+    MWAW_DEBUG_MSG(("MWAWGraphicDecoder::insertElement: called without any name\n"));
     return;
   }
+  insertElement(getElementId(psName), psName);
+}
 
-  bool ok=true;
-  switch (psName[0]) {
-  case 'C':
-    if (len>=6 && strncmp(psName,"Close",5)==0) {
-      psName+=5;
-      if (strcmp(psName,"Group")==0)
-        m_output->closeGroup();
-      else if (strcmp(psName,"Link")==0)
-        m_output->closeLink();
-      else if (strcmp(psName,"ListElement")==0)
-        m_output->closeListElement();
-      else if (strcmp(psName,"OrderedListLevel")==0)
-        m_output->closeOrderedListLevel();
-      else if (strcmp(psName,"Paragraph")==0)
-        m_output->closeParagraph();
-      else if (strcmp(psName,"Span")==0)
-        m_output->closeSpan();
-      else if (strcmp(psName,"TableCell")==0)
-        m_output->closeTableCell();
-      else if (strcmp(psName,"TableRow")==0)
-        m_output->closeTableRow();
-      else if (strcmp(psName,"UnorderedListLevel")==0)
-        m_output->closeUnorderedListLevel();
-      else
-        ok=false;
-    }
-    else
-      ok=false;
-    break;
-  case 'E':
-    if (len>=4 && strncmp(psName,"End",3)==0) {
-      psName+=3;
-      if (strcmp(psName,"Document")==0)
-        m_output->endDocument();
-      else if (strcmp(psName,"EmbeddedGraphics")==0)
-        m_output->endEmbeddedGraphics();
-      else if (strcmp(psName,"Layer")==0)
-        m_output->endLayer();
-      else if (strcmp(psName,"MasterPage")==0)
-        m_output->endMasterPage();
-      else if (strcmp(psName,"Page")==0)
-        m_output->endPage();
-      else if (strcmp(psName,"TableObject")==0)
-        m_output->endTableObject();
-      else if (strcmp(psName,"TextObject")==0)
-        m_output->endTextObject();
-      else
-        ok=false;
-    }
-    else
-      ok=false;
-    break;
-  case 'I':
-    if (len>=7 && strncmp(psName,"Insert",6)==0) {
-      psName+=6;
-      if (strcmp(psName,"LineBreak")==0)
-        m_output->insertLineBreak();
-      else if (strcmp(psName,"Space")==0)
-        m_output->insertSpace();
-      else if (strcmp(psName,"Tab")==0)
-        m_output->insertTab();
-      else
-        ok=false;
-    }
-    else
-      ok=false;
+void MWAWGraphicDecoder::insertElement(int id, const char *psName)
+{
+  if (!m_output) return;
+  switch (id) {
+  case MWAWGraphicDecoderInternal::E_CloseGroup:
+    m_output->closeGroup();
+    break;
+  case MWAWGraphicDecoderInternal::E_CloseLink:
+    m_output->closeLink();
+    break;
+  case MWAWGraphicDecoderInternal::E_CloseListElement:
+    m_output->closeListElement();
+    break;
+  case MWAWGraphicDecoderInternal::E_CloseOrderedListLevel:
+    m_output->closeOrderedListLevel();
+    break;
+  case MWAWGraphicDecoderInternal::E_CloseParagraph:
+    m_output->closeParagraph();
+    break;
+  case MWAWGraphicDecoderInternal::E_CloseSpan:
+    m_output->closeSpan();
+    break;
+  case MWAWGraphicDecoderInternal::E_CloseTableCell:
+    m_output->closeTableCell();
+    break;
+  case MWAWGraphicDecoderInternal::E_CloseTableRow:
+    m_output->closeTableRow();
+    break;
+  case MWAWGraphicDecoderInternal::E_CloseUnorderedListLevel:
+    m_output->closeUnorderedListLevel();
+    break;
+  case MWAWGraphicDecoderInternal::E_EndDocument:
+    m_output->endDocument();
+    break;
+  case MWAWGraphicDecoderInternal::E_EndEmbeddedGraphics:
+    m_output->endEmbeddedGraphics();
+    break;
+  case MWAWGraphicDecoderInternal::E_EndLayer:
+    m_output->endLayer();
+    break;
+  case MWAWGraphicDecoderInternal::E_EndMasterPage:
+    m_output->endMasterPage();
+    break;
+  case MWAWGraphicDecoderInternal::E_EndPage:
+    m_output->endPage();
+    break;
+  case MWAWGraphicDecoderInternal::E_EndTableObject:
+    m_output->endTableObject();
+    break;
+  case MWAWGraphicDecoderInternal::E_EndTextObject:
+    m_output->endTextObject();
+    break;
+  case MWAWGraphicDecoderInternal::E_InsertLineBreak:
+    m_output->insertLineBreak();
+    break;
+  case MWAWGraphicDecoderInternal::E_InsertSpace:
+    m_output->insertSpace();
+    break;
+  case MWAWGraphicDecoderInternal::E_InsertTab:
+    m_output->insertTab();
     break;
   default:
-    ok=false;
+    MWAW_DEBUG_MSG(("MWAWGraphicDecoder::insertElement: called with unexpected name %s\n", psName ? psName : "null"));
     break;
   }
-  if (!ok) {
-    MWAW_DEBUG_MSG(("MWAWGraphicDecoder::insertElement: called with unexpected name %s\n", psName));
-  }
 }
 
 void MWAWGraphicDecoder::insertElement(const char *psName, const librevenge::RVNGPropertyList &propList)
 {
-  if (!m_output) return;
-  int len=psName ? int(strlen(psName)) : 0;
-  if (!len) {
+  if (!psName || !*psName) {
     MWAW_DEBUG_MSG(("MWAWGraphicDecoder::insertElement: called without any name\n"));
     return;
   }
+  insertElement(getElementId(psName), psName, propList);
+}
 
-  bool ok=true;
-  switch (psName[0]) {
-  case 'D':
-    if (len>=7 && strncmp(psName,"Define",6)==0) {
-      psName+=6;
-      if (strcmp(psName,"CharacterStyle")==0)
-        m_output->defineCharacterStyle(propList);
-      else if (strcmp(psName,"EmbeddedFont")==0)
-        m_output->defineEmbeddedFont(propList);
-      else if (strcmp(psName,"ParagraphStyle")==0)
-        m_output->defineParagraphStyle(propList);
-      else
-        ok=false;
-    }
-    else if (len>=5 && strncmp(psName,"Draw",4)==0) {
-      psName+=4;
-      if (strcmp(psName,"Connector")==0)
-        m_output->drawConnector(propList);
-      else if (strcmp(psName,"Ellipse")==0)
-        m_output->drawEllipse(propList);
-      else if (strcmp(psName,"GraphicObject")==0)
-        m_output->drawGraphicObject(propList);
-      else if (strcmp(psName,"Path")==0)
-        m_output->drawPath(propList);
-      else if (strcmp(psName,"Polygon")==0)
-        m_output->drawPolygon(propList);
-      else if (strcmp(psName,"Polyline")==0)
-        m_output->drawPolyline(propList);
-      else if (strcmp(psName,"Rectangle")==0)
-        m_output->drawRectangle(propList);
-      else
-        ok=false;
-    }
-    else
-      ok=false;
-    break;
-  case 'I':
-    if (len>=7 && strncmp(psName,"Insert",6)==0) {
-      psName+=6;
-      if (strcmp(psName,"CoveredTableCell")==0)
-        m_output->insertCoveredTableCell(propList);
-      else if (strcmp(psName,"Field")==0)
-        m_output->insertField(propList);
-      else
-        ok=false;
-    }
-    else
-      ok=false;
-    break;
-  case 'O':
-    if (len>=5 && strncmp(psName,"Open",4)==0) {
-      psName+=4;
-      if (strcmp(psName,"Group")==0)
-        m_output->openGroup(propList);
-      else if (strcmp(psName,"Link")==0)
-        m_output->openLink(propList);
-      else if (strcmp(psName,"ListElement")==0)
-        m_output->openListElement(propList);
-      else if (strcmp(psName,"OrderedListLevel")==0)
-        m_output->openOrderedListLevel(propList);
-      else if (strcmp(psName,"Paragraph")==0)
-        m_output->openParagraph(propList);
-      else if (strcmp(psName,"Span")==0)
-        m_output->openSpan(propList);
-      else if (strcmp(psName,"TableCell")==0)
-        m_output->openTableCell(propList);
-      else if (strcmp(psName,"TableRow")==0)
-        m_output->openTableRow(propList);
-      else if (strcmp(psName,"UnorderedListLevel")==0)
-        m_output->openUnorderedListLevel(propList);
-      else
-        ok=false;
-    }
-    else
-      ok=false;
-    break;
-  case 'S':
-    if (len>=4 && strncmp(psName,"Set",3)==0) {
-      psName+=3;
-      if (strcmp(psName,"DocumentMetaData")==0)
-        m_output->setDocumentMetaData(propList);
-      else if (strcmp(psName,"Style")==0)
-        m_output->setStyle(propList);
-      else
-        ok=false;
-    }
-    else if (len>=6 && strncmp(psName,"Start",5)==0) {
-      psName+=5;
-      if (strcmp(psName,"Document")==0)
-        m_output->startDocument(propList);
-      else if (strcmp(psName,"EmbeddedGraphics")==0)
-        m_output->startEmbeddedGraphics(propList);
-      else if (strcmp(psName,"Layer")==0)
-        m_output->startLayer(propList);
-      else if (strcmp(psName,"MasterPage")==0)
-        m_output->startMasterPage(propList);
-      else if (strcmp(psName,"Page")==0)
-        m_output->startPage(propList);
-      else if (strcmp(psName,"TableObject")==0)
-        m_output->startTableObject(propList);
-      else if (strcmp(psName,"TextObject")==0)
-        m_output->startTextObject(propList);
-      else
-        ok=false;
-    }
-    else
-      ok=false;
+void MWAWGraphicDecoder::insertElement(int id, const char *psName, const librevenge::RVNGPropertyList &propList)
+{
+  if (!m_output) return;
+  switch (id) {
+  case MWAWGraphicDecoderInternal::E_DefineCharacterStyle:
+    m_output->defineCharacterStyle(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_DefineEmbeddedFont:
+    m_output->defineEmbeddedFont(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_DefineParagraphStyle:
+    m_output->defineParagraphStyle(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_DrawConnector:
+    m_output->drawConnector(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_DrawEllipse:
+    m_output->drawEllipse(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_DrawGraphicObject:
+    m_output->drawGraphicObject(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_DrawPath:
+    m_output->drawPath(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_DrawPolygon:
+    m_output->drawPolygon(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_DrawPolyline:
+    m_output->drawPolyline(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_DrawRectangle:
+    m_output->drawRectangle(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_InsertCoveredTableCell:
+    m_output->insertCoveredTableCell(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_InsertField:
+    m_output->insertField(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_OpenGroup:
+    m_output->openGroup(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_OpenLink:
+    m_output->openLink(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_OpenListElement:
+    m_output->openListElement(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_OpenOrderedListLevel:
+    m_output->openOrderedListLevel(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_OpenParagraph:
+    m_output->openParagraph(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_OpenSpan:
+    m_output->openSpan(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_OpenTableCell:
+    m_output->openTableCell(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_OpenTableRow:
+    m_output->openTableRow(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_OpenUnorderedListLevel:
+    m_output->openUnorderedListLevel(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_SetDocumentMetaData:
+    m_output->setDocumentMetaData(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_SetStyle:
+    m_output->setStyle(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_StartDocument:
+    m_output->startDocument(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_StartEmbeddedGraphics:
+    m_output->startEmbeddedGraphics(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_StartLayer:
+    m_output->startLayer(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_StartMasterPage:
+    m_output->startMasterPage(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_StartPage:
+    m_output->startPage(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_StartTableObject:
+    m_output->startTableObject(propList);
+    break;
+  case MWAWGraphicDecoderInternal::E_StartTextObject:
+    m_output->startTextObject(propList);
     break;
   default:
-    ok=false;
+    MWAW_DEBUG_MSG(("MWAWGraphicDecoder::insertElement: called with unexpected name %s\n", psName ? psName : "null"));
     break;
   }
-  if (!ok) {
-    MWAW_DEBUG_MSG(("MWAWGraphicDecoder::insertElement: called with unexpected name %s\n", psName));
-  }
 }
 
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -52,6 +52,7 @@
 #include "MWAWParagraph.hxx"
 #include "MWAWParser.hxx"
 #include "MWAWPosition.hxx"
+#include "MWAWPropertyListCache.hxx"
 #include "MWAWSection.hxx"
 #include "MWAWSubDocument.hxx"
 #include "MWAWTable.hxx"
@@ -67,7 +68,7 @@ struct GraphicState {
   GraphicState(std::vector<MWAWPageSpan> const &pageList) :
     m_pageList(pageList), m_metaData(),
     m_isDocumentStarted(false), m_isPageSpanOpened(false), m_isMasterPageSpanOpened(false), m_isAtLeastOnePageOpened(false),
-    m_isHeaderFooterStarted(false), m_pageSpan(), m_sentListMarkers(), m_subDocuments()
+    m_isHeaderFooterStarted(false), m_pageSpan(), m_sentListMarkers(), m_subDocuments(), m_propertyListCache()
   {
   }
   //! destructor
@@ -94,6 +95,8 @@ struct GraphicState {
   std::vector<int> m_sentListMarkers;
   //! the list of actual subdocument
   std::vector<MWAWSubDocumentPtr> m_subDocuments;
+  //! the cache of font and paragraph property lists
+  MWAWPropertyListCache m_propertyListCache;
 };
 
 /** the state of a MWAWGraphicListener */
@@ -267,6 +270,20 @@ int MWAWGraphicListener::insertCharacter(unsigned char c, MWAWInputStreamPtr &in
   return int(pos-debPos);
 }
 
+size_t MWAWGraphicListener::insertCharacters(unsigned char const *str, size_t len)
+{
+  if (!m_ps->isInTextZone()) {
+    MWAW_DEBUG_MSG(("MWAWGraphicListener::insertCharacters: called outside a text zone\n"));
+    return len;
+  }
+  if (!str || !len || !m_parserState.m_fontConverter) {
+    MWAW_DEBUG_MSG(("MWAWGraphicListener::insertCharacters: called without characters or font converter\n"));
+    return len;
+  }
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  return m_parserState.m_fontConverter->unicode(m_ps->m_font.id(), str, len, m_ps->m_textBuffer);
+}
+
 void MWAWGraphicListener::insertUnicode(uint32_t val)
 {
   if (!m_ps->isInTextZone()) {
@@ -651,7 +668,7 @@ void MWAWGraphicListener::_openParagraph()
   }
 
   librevenge::RVNGPropertyList propList;
-  m_ps->m_paragraph.addTo(propList, m_ps->m_isTableCellOpened);
+  m_ds->m_propertyListCache.getParagraphProperties(m_ps->m_paragraph, m_ps->m_isTableCellOpened, propList);
   m_documentInterface->openParagraph(propList);
 
   _resetParagraphState();
@@ -701,7 +718,7 @@ void MWAWGraphicListener::_openListElement()
     return;
 
   librevenge::RVNGPropertyList propList;
-  m_ps->m_paragraph.addTo(propList,m_ps->m_isTableOpened);
+  m_ds->m_propertyListCache.getParagraphProperties(m_ps->m_paragraph, m_ps->m_isTableOpened, propList);
 
   // check if we must change the start value
   int startValue=m_ps->m_paragraph.m_listStartValue.get();
@@ -822,7 +839,7 @@ void MWAWGraphicListener::_openSpan()
   }
 
   librevenge::RVNGPropertyList propList;
-  m_ps->m_font.addTo(propList, m_parserState.m_fontConverter);
+  m_ds->m_propertyListCache.getFontProperties(m_ps->m_font, m_parserState.m_fontConverter, propList);
 
   m_documentInterface->openSpan(propList);
 
@@ -1027,7 +1044,7 @@ void MWAWGraphicListener::insertPicture
   }
 
   librevenge::RVNGPropertyList list, shapePList;
-  style.addTo(list, shape.getType()==MWAWGraphicShape::Line);
+  style.addTo(list, shape.getType()==MWAWGraphicShape::Line, &m_ds->m_propertyListCache);
   m_documentInterface->setStyle(list);
   switch (shape.addTo(1.f/pos.getInvUnitScale(librevenge::RVNG_POINT)*pos.origin()-m_ps->m_origin, style.hasSurface(), shapePList)) {
   case MWAWGraphicShape::C_Ellipse:
@@ -1067,7 +1084,7 @@ void MWAWGraphicListener::insertPicture
   if (!m_ds->m_isPageSpanOpened)
     _openPageSpan();
   librevenge::RVNGPropertyList list;
-  style.addTo(list);
+  style.addTo(list, false, &m_ds->m_propertyListCache);
   m_documentInterface->setStyle(list);
 
   list.clear();
@@ -1441,7 +1458,7 @@ void MWAWGraphicListener::_handleFrameParameters(librevenge::RVNGPropertyList &l
     list.insert("draw:fill", "none");
   }
   else
-    style.addTo(list);
+    style.addTo(list, false, &m_ds->m_propertyListCache);
 
   list.insert("svg:x",originPt[0], librevenge::RVNG_POINT);
   list.insert("svg:y",originPt[1], librevenge::RVNG_POINT);
@@ -47,6 +47,7 @@
 
 #include "MWAWFontConverter.hxx"
 #include "MWAWPictBitmap.hxx"
+#include "MWAWPropertyListCache.hxx"
 
 #include "MWAWGraphicStyle.hxx"
 
@@ -155,7 +156,7 @@ void MWAWGraphicStyle::setBorders(int wh, MWAWBorder const &border)
   if (wh & libmwaw::BottomBit) m_bordersList[libmwaw::Bottom] = border;
 }
 
-void MWAWGraphicStyle::addTo(librevenge::RVNGPropertyList &list, bool only1D) const
+void MWAWGraphicStyle::addTo(librevenge::RVNGPropertyList &list, bool only1D, MWAWPropertyListCache *cache) const
 {
   if (!hasLine())
     list.insert("draw:stroke", "none");
@@ -314,7 +315,7 @@ void MWAWGraphicStyle::addTo(librevenge::RVNGPropertyList &list, bool only1D) co
       else {
         librevenge::RVNGBinaryData data;
         std::string mimeType;
-        if (m_pattern.getBinary(data, mimeType)) {
+        if (cache ? cache->getPatternBinary(m_pattern, data, mimeType) : m_pattern.getBinary(data, mimeType)) {
           list.insert("draw:fill", "bitmap");
           list.insert("draw:fill-image", data.getBase64Data());
           list.insert("draw:fill-image-width", m_pattern.m_dim[0], librevenge::RVNG_POINT);
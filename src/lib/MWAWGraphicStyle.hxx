@@ -297,8 +297,10 @@ public:
   void setBorders(int wh, MWAWBorder const &border);
   //! a print operator
   friend std::ostream &operator<<(std::ostream &o, MWAWGraphicStyle const &st);
-  //! add all the parameters to the propList excepted the frame parameter: the background and the borders
-  void addTo(librevenge::RVNGPropertyList &pList, bool only1d=false) const;
+  /** add all the parameters to the propList excepted the frame parameter: the background and the borders
+
+      \note if cache is set, it is used to retrieve the encoded bitmap patterns */
+  void addTo(librevenge::RVNGPropertyList &pList, bool only1d=false, MWAWPropertyListCache *cache=0) const;
   //! add all the frame parameters to propList: the background and the borders
   void addFrameTo(librevenge::RVNGPropertyList &pList) const;
   /** compare two styles */
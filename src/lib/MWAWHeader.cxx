@@ -773,37 +773,19 @@ std::vector<MWAWHeader> MWAWHeader::constructHeader
   if (input->size()>=512+720*2) {
     // check for a MacPaint file
     input->seek(512, librevenge::RVNG_SEEK_SET);
-    bool ok=true;
-    // check the first 3 row
-    for (int row=0; row<3; ++row) {
-      int lastColor=-1;
-      int col=0;
-      while (col<72) {
-        if (input->tell()+2>input->size()) {
-          ok=false;
-          break;
-        }
-        int wh=(int) input->readULong(1);
-        if (wh>=0x81) {
-          int color=(int) input->readULong(1);
-          // consider that repeat color is anormal...
-          if (col+(0x101-wh)>72 || (lastColor>=0 && color==lastColor)) {
-            ok=false;
-            break;
-          }
-          col+=(0x101-wh);
-          lastColor=color;
-          continue;
-        }
-        if (col+1+wh>72) {
-          ok=false;
-          break;
-        }
-        lastColor=-1;
-        col += wh+1;
-        input->seek(wh+1, librevenge::RVNG_SEEK_CUR);
-      }
-      if (!ok) break;
+    // a row is stored in at most 144 bytes, read enough data to check the first 3 rows
+    unsigned long numRead;
+    unsigned char const *data=input->read(3*144, numRead);
+    bool ok=data!=0;
+    libmwaw::PackBitsDecoder decoder;
+    for (int row=0; ok && row<3; ++row) {
+      // consider that repeat color is anormal...
+      if (!decoder.decode(data, numRead, 0, 72) || decoder.getNumSameRepeats()) {
+        ok=false;
+        break;
+      }
+      data+=decoder.getNumRead();
+      numRead-=decoder.getNumRead();
     }
     if (ok) {
       MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a MacPaint file\n"));
@@ -33,6 +33,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <limits>
 #include <cmath>
 #include <cstring>
@@ -40,13 +41,22 @@
 #include <librevenge-stream/librevenge-stream.h>
 #include <librevenge/librevenge.h>
 
+#include <libmwaw/MWAWFileStream.hxx>
+
 #include "MWAWDebug.hxx"
 
 #include "MWAWInputStream.hxx"
+#include "MWAWStreamView.hxx"
 #include "MWAWStringStream.hxx"
 
+//! the default size of the read window
+static unsigned long const s_windowSize=0x4000;
+//! the maximal size of a read window created to cover a section
+static unsigned long const s_windowMaxSectionSize=0x100000;
+
 MWAWInputStream::MWAWInputStream(shared_ptr<librevenge::RVNGInputStream> inp, bool inverted)
   : m_stream(inp), m_streamSize(0), m_inverseRead(inverted), m_readLimit(-1), m_prevLimits(),
+    m_isMemoryStream(false), m_window(0), m_windowSize(0), m_windowPos(0), m_windowOffset(0),
     m_fInfoType(""), m_fInfoCreator(""), m_resourceFork()
 {
   updateStreamSize();
@@ -54,6 +64,7 @@ MWAWInputStream::MWAWInputStream(shared_ptr<librevenge::RVNGInputStream> inp, bo
 
 MWAWInputStream::MWAWInputStream(librevenge::RVNGInputStream *inp, bool inverted, bool checkCompression)
   : m_stream(), m_streamSize(0), m_inverseRead(inverted), m_readLimit(-1), m_prevLimits(),
+    m_isMemoryStream(false), m_window(0), m_windowSize(0), m_windowPos(0), m_windowOffset(0),
     m_fInfoType(""), m_fInfoCreator(""), m_resourceFork()
 {
   if (!inp) return;
@@ -106,6 +117,13 @@ shared_ptr<MWAWInputStream> MWAWInputStream::get(librevenge::RVNGBinaryData cons
 
 void MWAWInputStream::updateStreamSize()
 {
+  syncWindow();
+  // a view does not copy data if its main input does not
+  librevenge::RVNGInputStream *input=m_stream.get();
+  while (dynamic_cast<MWAWStreamView *>(input))
+    input=static_cast<MWAWStreamView *>(input)->getInput().get();
+  m_isMemoryStream=dynamic_cast<MWAWFileStream *>(input)!=0 ||
+                   dynamic_cast<MWAWStringStream *>(input)!=0;
   if (!m_stream)
     m_streamSize=0;
   else {
@@ -120,10 +138,140 @@ const uint8_t *MWAWInputStream::read(size_t numBytes, unsigned long &numBytesRea
 {
   if (!hasDataFork())
     throw libmwaw::FileException();
+  if (numBytes && m_window && m_windowPos+(unsigned long)numBytes<=m_windowSize) {
+    uint8_t const *res=m_window+m_windowPos;
+    m_windowPos+=(unsigned long)numBytes;
+    numBytesRead=(unsigned long)numBytes;
+    return res;
+  }
+  syncWindow();
   return m_stream->read(numBytes,numBytesRead);
 }
 
-long MWAWInputStream::tell()
+bool MWAWInputStream::fillWindow(unsigned long minSize)
+{
+  if (!m_stream || !minSize) return false;
+  if (m_window && m_windowPos+minSize<=m_windowSize) return true;
+  syncWindow();
+  long pos=m_stream->tell();
+  if (pos<0 || pos+long(minSize)>m_streamSize) return false;
+  // try to cover the actual section, if it is not too big
+  unsigned long len=s_windowSize;
+  if (m_isMemoryStream) // reading does not copy data, so we can take all
+    len=(unsigned long)(m_streamSize-pos);
+  else if (m_readLimit>pos && (unsigned long)(m_readLimit-pos)>len &&
+           (unsigned long)(m_readLimit-pos)<=s_windowMaxSectionSize)
+    len=(unsigned long)(m_readLimit-pos);
+  if (len<minSize)
+    len=minSize;
+  if (pos+long(len)>m_streamSize)
+    len=(unsigned long)(m_streamSize-pos);
+  unsigned long numRead=0;
+  unsigned char const *data=m_stream->read(len, numRead);
+  if (!data || numRead<minSize) {
+    m_stream->seek(pos, librevenge::RVNG_SEEK_SET);
+    return false;
+  }
+  m_window=data;
+  m_windowSize=numRead;
+  m_windowPos=0;
+  m_windowOffset=pos;
+  return true;
+}
+
+unsigned long MWAWInputStream::readULongFromStream(int num)
+{
+  if (num>0 && num<=8 && fillWindow((unsigned long) num)) {
+    unsigned char const *p=m_window+m_windowPos;
+    m_windowPos+=(unsigned long) num;
+    unsigned long res=0;
+    if (m_inverseRead) {
+      for (int i=num-1; i>=0; --i)
+        res=(res<<8)|(unsigned long)p[i];
+    }
+    else {
+      for (int i=0; i<num; ++i)
+        res=(res<<8)|(unsigned long)p[i];
+    }
+    return res;
+  }
+  // end of file or odd size: let the basic stream do the job
+  syncWindow();
+  return readULong(m_stream.get(), num, 0, m_inverseRead);
+}
+
+bool MWAWInputStream::findNext(std::vector<std::string> const &patterns, long endPos)
+{
+  if (!hasDataFork()) return false;
+  if (endPos<0 || endPos>m_streamSize) endPos=m_streamSize;
+  if (m_readLimit>0 && endPos>m_readLimit) endPos=m_readLimit;
+  // find the first characters and the lengths of the patterns
+  bool isFirst[256];
+  std::fill(isFirst, isFirst+256, false);
+  int numFirst=0;
+  unsigned char first=0;
+  unsigned long minLength=0, maxLength=0;
+  for (size_t p=0; p<patterns.size(); ++p) {
+    std::string const &pattern=patterns[p];
+    if (pattern.empty()) continue;
+    unsigned long length=(unsigned long) pattern.length();
+    if (!minLength || length<minLength) minLength=length;
+    if (length>maxLength) maxLength=length;
+    unsigned char c=(unsigned char) pattern[0];
+    if (isFirst[c]) continue;
+    isFirst[c]=true;
+    first=c;
+    ++numFirst;
+  }
+  if (!minLength) return false;
+
+  long pos=tell();
+  while (pos<endPos && pos+long(minLength)<=m_streamSize) {
+    seek(pos, librevenge::RVNG_SEEK_SET);
+    unsigned long needed=maxLength;
+    if (pos+long(needed)>m_streamSize)
+      needed=(unsigned long)(m_streamSize-pos);
+    if (!fillWindow(needed)) break;
+    unsigned char const *data=m_window+m_windowPos;
+    unsigned long dataSize=m_windowSize-m_windowPos;
+    unsigned long numPos=(unsigned long)(endPos-pos);
+    if (numPos>dataSize) numPos=dataSize;
+    bool restart=false;
+    unsigned long i=0;
+    while (i<numPos) {
+      if (numFirst==1) {
+        unsigned char const *next=(unsigned char const *) memchr(data+i, first, numPos-i);
+        if (!next) break;
+        i=(unsigned long)(next-data);
+      }
+      else if (!isFirst[data[i]]) {
+        ++i;
+        continue;
+      }
+      if (i && i+maxLength>dataSize && pos+long(i+maxLength)<=m_streamSize) {
+        // a pattern can cross the window end, create a new window which begins here
+        pos+=long(i);
+        restart=true;
+        break;
+      }
+      for (size_t p=0; p<patterns.size(); ++p) {
+        std::string const &pattern=patterns[p];
+        if (pattern.empty() || i+pattern.length()>dataSize ||
+            memcmp(data+i, pattern.c_str(), pattern.length())!=0)
+          continue;
+        seek(pos+long(i), librevenge::RVNG_SEEK_SET);
+        return true;
+      }
+      ++i;
+    }
+    if (!restart)
+      pos+=long(numPos);
+  }
+  seek(endPos, librevenge::RVNG_SEEK_SET);
+  return false;
+}
+
+long MWAWInputStream::tellStream()
 {
   if (!hasDataFork())
     return 0;
@@ -150,6 +298,13 @@ int MWAWInputStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
   if (offset > size())
     offset = size();
 
+  if (m_window) {
+    if (offset>=m_windowOffset && offset<=m_windowOffset+long(m_windowSize)) {
+      m_windowPos=(unsigned long)(offset-m_windowOffset);
+      return 0;
+    }
+    resetWindow();
+  }
   return m_stream->seek(offset, librevenge::RVNG_SEEK_SET);
 }
 
@@ -157,9 +312,10 @@ bool MWAWInputStream::isEnd()
 {
   if (!hasDataFork())
     return true;
-  long pos = m_stream->tell();
+  long pos = tell();
   if (m_readLimit > 0 && pos >= m_readLimit) return true;
   if (pos >= size()) return true;
+  if (m_window) return false;
 
   return m_stream->isEnd();
 }
@@ -198,24 +354,6 @@ unsigned long MWAWInputStream::readULong(librevenge::RVNGInputStream *stream, in
   return 0;
 }
 
-long MWAWInputStream::readLong(int num)
-{
-  long v = long(readULong(num));
-  switch (num) {
-  case 4:
-    return (int32_t) v;
-  case 2:
-    return (int16_t) v;
-  case 1:
-    return (int8_t) v;
-  default:
-    break;
-  }
-
-  if ((v & long(0x1 << (num*8-1))) == 0) return v;
-  return v | long(0xFFFFFFFF << 8*num);
-}
-
 uint8_t MWAWInputStream::readU8(librevenge::RVNGInputStream *stream)
 {
   if (!stream)
@@ -362,6 +500,149 @@ bool MWAWInputStream::readDoubleReverted8(double &res, bool &isNotANumber)
 // BinHex 4.0
 //
 ////////////////////////////////////////////////////////////
+/** Internal: the structures used to decode a BinHex 4.0 file */
+namespace MWAWInputStreamBinHexInternal
+{
+//! Internal: a decoder which converts the BinHex characters and expands the repeated characters
+struct Decoder {
+  //! constructor
+  Decoder() : m_content(), m_numActByte(0), m_actVal(0), m_findRepetitif(false), m_ok(true)
+  {
+    static char const binChar[65] = "!\"#$%&'()*+,-012345689@ABCDEFGHIJKLMNPQRSTUVXYZ[`abcdefhijklmpqr";
+    for (int i=0; i < 256; ++i) m_binValues[i]=-1;
+    for (int i=0; i < 64; ++i) m_binValues[(unsigned char)binChar[i]]=i;
+  }
+  //! returns the value corresponding to a character or -1
+  int getValue(unsigned char c) const
+  {
+    return m_binValues[c];
+  }
+  //! adds a 6 bits value, if endData is set, this is the last value
+  void add(int readVal, bool endData)
+  {
+    int wVal = -1;
+    if (m_numActByte==0)
+      m_actVal |= (readVal<<2);
+    else if (m_numActByte==2) {
+      wVal = (m_actVal | readVal);
+      m_actVal = 0;
+    }
+    else if (m_numActByte==4) {
+      wVal = m_actVal | ((readVal>>2)&0xF);
+      m_actVal = (readVal&0x3)<<6;
+    }
+    else if (m_numActByte==6) {
+      wVal = m_actVal | ((readVal>>4)&0x3);
+      m_actVal = (readVal&0xf)<<4;
+    }
+    m_numActByte = (m_numActByte+6)%8;
+    if (wVal != -1) write((unsigned char) wVal);
+    if (endData && m_actVal) write((unsigned char) m_actVal);
+  }
+  //! writes a decoded byte, expands the 0x90 sequences
+  void write(unsigned char value)
+  {
+    if (!m_findRepetitif) {
+      if (value == 0x90)
+        m_findRepetitif = true;
+      else
+        m_content.push_back(value);
+      return;
+    }
+    if (value == 1 || value == 2) {
+      MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find bad value after repetif character\n"));
+      m_ok=false;
+      return;
+    }
+    m_findRepetitif = false;
+    if (value == 0) {
+      m_content.push_back(0x90);
+      return;
+    }
+    if (m_content.empty()) {
+      MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find repetif character in the first position\n"));
+      m_ok=false;
+      return;
+    }
+    size_t const actSize=m_content.size();
+    m_content.resize(actSize+size_t(value-1));
+    std::memset(&m_content[actSize], m_content[actSize-1], size_t(value-1));
+  }
+  //! the decoded content
+  std::vector<unsigned char> m_content;
+  //! the position in the current 8 bits
+  int m_numActByte;
+  //! the current partial byte
+  int m_actVal;
+  //! a flag to know if we have found a 0x90 character
+  bool m_findRepetitif;
+  //! a flag to know if the data are valid
+  bool m_ok;
+  //! the BinHex value of each character or -1
+  int m_binValues[256];
+};
+
+//! the CRC-CCITT table (polynomial 0x1021)
+static unsigned const s_crcTable[256]= {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+  0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+  0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
+  0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de,
+  0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
+  0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d,
+  0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4,
+  0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d, 0xc7bc,
+  0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
+  0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
+  0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12,
+  0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a,
+  0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41,
+  0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b, 0x8d68, 0x9d49,
+  0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
+  0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78,
+  0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f,
+  0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
+  0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e,
+  0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
+  0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d,
+  0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+  0xa7db, 0xb7fa, 0x8799, 0x97b8, 0xe75f, 0xf77e, 0xc71d, 0xd73c,
+  0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634,
+  0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
+  0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3,
+  0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
+  0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92,
+  0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9,
+  0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
+  0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
+  0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0
+};
+
+//! returns the BinHex CRC (ie. a CRC-CCITT with a null initial value) of a buffer
+static unsigned getCRC(unsigned char const *data, size_t len)
+{
+  unsigned crc=0;
+  for (size_t i=0; i < len; ++i)
+    crc=((crc<<8)^s_crcTable[((crc>>8)^data[i])&0xFF])&0xFFFF;
+  return crc;
+}
+
+//! reads a big endian value in a buffer
+static unsigned long readULong(unsigned char const *data, int num)
+{
+  unsigned long res=0;
+  for (int i=0; i < num; ++i)
+    res=(res<<8)|data[i];
+  return res;
+}
+
+//! returns true if the CRC which follows a zone is valid
+static bool checkCRC(unsigned char const *data, size_t len)
+{
+  return getCRC(data, len)==(unsigned) readULong(data+len, 2);
+}
+}
+
 bool MWAWInputStream::unBinHex()
 {
   if (!hasDataFork() || size() < 45)
@@ -386,81 +667,47 @@ bool MWAWInputStream::unBinHex()
   if (isEnd() || !numEOL || ((char)readLong(1))!= ':')
     return false;
 
-  // first phase reconstruct the file
-  static char const binChar[65] = "!\"#$%&'()*+,-012345689@ABCDEFGHIJKLMNPQRSTUVXYZ[`abcdefhijklmpqr";
-  std::map<unsigned char,int>  binMap;
-  for (int i = 0; i < 64; i++) binMap[(unsigned char)binChar[i]]=i;
-  bool endData = false;
-  int numActByte = 0, actVal = 0;
-  librevenge::RVNGBinaryData content;
-  bool findRepetitif = false;
-  while (1) {
+  // first phase reconstruct the file, the input is read by blocks
+  MWAWInputStreamBinHexInternal::Decoder decoder;
+  std::vector<unsigned char> &content=decoder.m_content;
+  // the 6 bits characters are decoded in 3/4 bytes, the content will probably be a little shorter
+  content.reserve(size_t(size()-tell())*3/4);
+  bool endData=false, sizeChecked=false;
+  while (!endData) {
     if (isEnd()) {
       MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: do not find ending ':' character\n"));
       return false;
     }
-    unsigned char c = (unsigned char) readLong(1);
-    if (c == '\n') continue;
-    int readVal = 0;
-    if (c == ':')
-      endData = true;
-    else if (binMap.find(c) == binMap.end()) {
-      MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find unexpected char when decoding file\n"));
+    unsigned char const *buffer=read(0x10000, nRead);
+    if (!buffer || !nRead) {
+      MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: can not read the input\n"));
       return false;
     }
-    else
-      readVal = binMap.find(c)->second;
-    int wVal = -1;
-    if (numActByte==0)
-      actVal |= (readVal<<2);
-    else if (numActByte==2) {
-      wVal = (actVal | readVal);
-      actVal = 0;
-    }
-    else if (numActByte==4) {
-      wVal = actVal | ((readVal>>2)&0xF);
-      actVal = (readVal&0x3)<<6;
-    }
-    else if (numActByte==6) {
-      wVal = actVal | ((readVal>>4)&0x3);
-      actVal = (readVal&0xf)<<4;
-    }
-    numActByte = (numActByte+6)%8;
-
-    int maxToWrite = (endData&&actVal) ? 2 : 1;
-    for (int wPos = 0; wPos < maxToWrite; wPos++) {
-      int value = wPos ? actVal : wVal;
-      if (value == -1) continue;
-      if (!findRepetitif && value != 0x90) {
-        content.append((unsigned char) value);
-        continue;
-      }
-      if (value == 0x90 && !findRepetitif) {
-        findRepetitif = true;
-        continue;
-      }
-
-      if (value == 1 || value == 2) {
-        MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find bad value after repetif character\n"));
-        return false;
-      }
-      findRepetitif = false;
-      if (value == 0) {
-        content.append(0x90);
-        continue;
-      }
-      if (content.size()==0) {
-        MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find repetif character in the first position\n"));
+    for (unsigned long i=0; i < nRead; ++i) {
+      unsigned char c = buffer[i];
+      if (c == '\n') continue;
+      int readVal = 0;
+      if (c == ':')
+        endData = true;
+      else if ((readVal=decoder.getValue(c)) == -1) {
+        MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find unexpected char when decoding file\n"));
         return false;
       }
-      unsigned char lChar = content.getDataBuffer()[content.size()-1];
-      for (int i = 0; i < value-1; i++)
-        content.append(lChar);
-      continue;
+      decoder.add(readVal, endData);
+      if (!decoder.m_ok) return false;
+      if (endData) break;
     }
-    if (endData) break;
+    if (sizeChecked || content.empty() || content.size() < size_t(content[0])+22)
+      continue;
+    // we know the header, we can reserve the final size
+    sizeChecked=true;
+    size_t const headerSize=size_t(content[0])+22;
+    unsigned long const dataLength=MWAWInputStreamBinHexInternal::readULong(&content[headerSize-10], 4);
+    unsigned long const rsrcLength=MWAWInputStreamBinHexInternal::readULong(&content[headerSize-6], 4);
+    if (dataLength < 0x10000000 && rsrcLength < 0x10000000)
+      content.reserve(headerSize+size_t(dataLength)+size_t(rsrcLength)+4);
   }
-  if (findRepetitif) {
+  if (decoder.m_findRepetitif) {
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find repetif character in the last position\n"));
     return false;
   }
@@ -469,22 +716,21 @@ bool MWAWInputStream::unBinHex()
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the content file is too small\n"));
     return false;
   }
-  librevenge::RVNGInputStream *contentInput=const_cast<librevenge::RVNGInputStream *>(content.getDataStream());
-  int fileLength = (int)  readU8(contentInput);
+  int fileLength = (int) content[0];
   if (fileLength < 1 || fileLength > 64 || long(fileLength+21) > contentSize) {
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the file name size seems odd\n"));
     return false;
   }
-  contentInput->seek(fileLength+1, librevenge::RVNG_SEEK_CUR); // filename + version
+  long pos=fileLength+2; // filename + version
   // creator, type
   std::string type(""), creator("");
   for (int p = 0; p < 4; p++) {
-    char c = (char) readU8(contentInput);
+    char c = (char) content[size_t(pos++)];
     if (c)
       type += c;
   }
   for (int p = 0; p < 4; p++) {
-    char c = (char) readU8(contentInput);
+    char c = (char) content[size_t(pos++)];
     if (c)
       creator += c;
   }
@@ -495,45 +741,39 @@ bool MWAWInputStream::unBinHex()
   else if (creator.length() || type.length()) {
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the file name size seems odd\n"));
   }
-  contentInput->seek(2, librevenge::RVNG_SEEK_CUR); // skip flags
-  long dataLength = (long) readULong(contentInput,4,0,false);
-  long rsrcLength = (long) readULong(contentInput,4,0,false);
-  long pos = contentInput->tell()+2; // skip CRC
+  pos += 2; // skip flags
+  long dataLength = (long) MWAWInputStreamBinHexInternal::readULong(&content[size_t(pos)], 4);
+  long rsrcLength = (long) MWAWInputStreamBinHexInternal::readULong(&content[size_t(pos)+4], 4);
+  pos += 8;
+  if (pos+2 <= contentSize && !MWAWInputStreamBinHexInternal::checkCRC(&content[0], size_t(pos))) {
+    MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the header CRC seems bad\n"));
+  }
+  pos += 2; // skip CRC
   if (dataLength<0 || rsrcLength < 0 || (dataLength==0 && rsrcLength==0) ||
       pos+dataLength+rsrcLength+4 > contentSize) {
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the data/rsrc fork size seems odd\n"));
     return false;
   }
+  // only check the CRC, the data are often still readable when they are bad
+  if (!MWAWInputStreamBinHexInternal::checkCRC(&content[size_t(pos)], size_t(dataLength))) {
+    MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the data fork CRC seems bad\n"));
+  }
+  if (!MWAWInputStreamBinHexInternal::checkCRC(&content[size_t(pos+dataLength+2)], size_t(rsrcLength))) {
+    MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the resource fork CRC seems bad\n"));
+  }
   // now read the rsrc and the data fork
   if (rsrcLength && getResourceForkStream()) {
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: I already have a resource fork!!!!\n"));
   }
   else if (rsrcLength) {
-    contentInput->seek(pos+dataLength+2, librevenge::RVNG_SEEK_SET);
-    unsigned long numBytesRead = 0;
-    const unsigned char *data =
-      contentInput->read((unsigned long)rsrcLength, numBytesRead);
-    if (numBytesRead != (unsigned long)rsrcLength || !data) {
-      MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: can not read the resource fork\n"));
-    }
-    else {
-      shared_ptr<librevenge::RVNGInputStream> rsrc(new MWAWStringStream(data, (unsigned int)numBytesRead));
-      m_resourceFork.reset(new MWAWInputStream(rsrc,false));
-    }
+    shared_ptr<librevenge::RVNGInputStream> rsrc(new MWAWStringStream(&content[size_t(pos+dataLength+2)], (unsigned int)rsrcLength));
+    m_resourceFork.reset(new MWAWInputStream(rsrc,false));
   }
+  resetWindow();
   if (!dataLength)
     m_stream.reset();
-  else {
-    contentInput->seek(pos, librevenge::RVNG_SEEK_SET);
-    unsigned long numBytesRead = 0;
-    const unsigned char *data =
-      contentInput->read((unsigned long)dataLength, numBytesRead);
-    if (numBytesRead != (unsigned long)dataLength || !data) {
-      MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: can not read the data fork\n"));
-      return false;
-    }
-    m_stream.reset(new MWAWStringStream(data, (unsigned int)numBytesRead));
-  }
+  else
+    m_stream.reset(new MWAWStringStream(&content[size_t(pos)], (unsigned int)dataLength));
 
   return true;
 }
@@ -556,6 +796,7 @@ bool MWAWInputStream::unzipStream()
     if (name.empty() || name[name.length()-1]=='/') continue;
     names.push_back(nm);
   }
+  resetWindow();
   if (names.size() == 1) {
     // ok as the OLE file must have at least MN and MN0 OLE
     m_stream.reset(m_stream->getSubStreamByName(names[0].c_str()));
@@ -611,6 +852,7 @@ bool MWAWInputStream::unMacMIME()
       ok = false;
     }
     if (ok) {
+      resetWindow();
       m_stream = newDataInput;
       if (newRsrcInput) {
         if (m_resourceFork) {
@@ -685,44 +927,64 @@ bool MWAWInputStream::unMacMIME(MWAWInputStream *inp,
         MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: can not seek entry pos %lx\n", (long unsigned int) entryPos));
         return false;
       }
+      if ((wh==1 || wh==2) && inp->m_isMemoryStream) {
+        /* the fork is not compressed and reading the input does not
+           refill a shared buffer, so we can use a view on the input
+           instead of copying it */
+        if (entrySize > (unsigned long)(inp->size()-entryPos)) {
+          MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: can not read %lX byte\n", (long unsigned int) entryPos));
+          return false;
+        }
+        shared_ptr<librevenge::RVNGInputStream> view(new MWAWStreamView(inp->m_stream, entryPos, long(entrySize)));
+        if (wh==1)
+          dataInput=view;
+        else
+          rsrcInput=view;
+        inp->seek(pos+12, librevenge::RVNG_SEEK_SET);
+        continue;
+      }
       unsigned long numBytesRead = 0;
       const unsigned char *data = inp->read(entrySize, numBytesRead);
       if (numBytesRead != entrySize || !data) {
         MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: can not read %lX byte\n", (long unsigned int) entryPos));
         return false;
       }
-      if (wh==1)
-        dataInput.reset(new MWAWStringStream(data, (unsigned int)numBytesRead));
-      else if (wh==2)
-        rsrcInput.reset(new MWAWStringStream(data, (unsigned int)numBytesRead));
-      else { // the finder info
-        if (entrySize < 8) {
-          MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: finder info size is odd\n"));
-        }
-        else {
-          bool ok = true;
-          std::string type(""), creator("");
-          for (int p = 0; p < 4; p++) {
-            if (!data[p]) {
-              ok = false;
-              break;
-            }
-            type += char(data[p]);
-          }
-          for (int p = 4; ok && p < 8; p++) {
-            if (!data[p]) {
-              ok = false;
-              break;
-            }
-            creator += char(data[p]);
-          }
-          if (ok) {
-            m_fInfoType = type;
-            m_fInfoCreator = creator;
+      if (wh==1 || wh==2) {
+        /* the data returned by read can be refilled by the next read, so
+           each fork needs its own copy */
+        shared_ptr<librevenge::RVNGInputStream> fork(new MWAWStringStream(data, (unsigned int)numBytesRead));
+        if (wh==1)
+          dataInput=fork;
+        else
+          rsrcInput=fork;
+      }
+      // the finder info
+      else if (entrySize < 8) {
+        MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: finder info size is odd\n"));
+      }
+      else {
+        bool ok = true;
+        std::string type(""), creator("");
+        for (int p = 0; p < 4; p++) {
+          if (!data[p]) {
+            ok = false;
+            break;
           }
-          else if (type.length()) {
-            MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: can not read find info\n"));
+          type += char(data[p]);
+        }
+        for (int p = 4; ok && p < 8; p++) {
+          if (!data[p]) {
+            ok = false;
+            break;
           }
+          creator += char(data[p]);
+        }
+        if (ok) {
+          m_fInfoType = type;
+          m_fInfoCreator = creator;
+        }
+        else if (type.length()) {
+          MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: can not read find info\n"));
         }
       }
 
@@ -744,6 +1006,7 @@ bool MWAWInputStream::unMacMIME(MWAWInputStream *inp,
 bool MWAWInputStream::isStructured()
 {
   if (!m_stream) return false;
+  syncWindow();
   long pos=m_stream->tell();
   bool ok=m_stream->isStructured();
   m_stream->seek(pos, librevenge::RVNG_SEEK_SET);
@@ -782,6 +1045,7 @@ shared_ptr<MWAWInputStream> MWAWInputStream::getSubStreamByName(std::string cons
   }
 
   long actPos = tell();
+  syncWindow();
   seek(0, librevenge::RVNG_SEEK_SET);
   shared_ptr<librevenge::RVNGInputStream> res(m_stream->getSubStreamByName(name.c_str()));
   seek(actPos, librevenge::RVNG_SEEK_SET);
@@ -802,6 +1066,7 @@ shared_ptr<MWAWInputStream> MWAWInputStream::getSubStreamById(unsigned id)
   }
 
   long actPos = tell();
+  syncWindow();
   seek(0, librevenge::RVNG_SEEK_SET);
   shared_ptr<librevenge::RVNGInputStream> res(m_stream->getSubStreamById(id));
   seek(actPos, librevenge::RVNG_SEEK_SET);
@@ -830,6 +1095,12 @@ bool MWAWInputStream::readDataBlock(long sz, librevenge::RVNGBinaryData &data)
   if (endPos > size()) return false;
   if (m_readLimit > 0 && endPos > (long)m_readLimit) return false;
 
+  if (m_window && m_windowPos+(unsigned long)sz<=m_windowSize) {
+    data.append(m_window+m_windowPos, (unsigned long)sz);
+    m_windowPos+=(unsigned long)sz;
+    return true;
+  }
+  syncWindow();
   const unsigned char *readData;
   unsigned long sizeRead;
   if ((readData=m_stream->read((unsigned long)sz, sizeRead)) == 0 || long(sizeRead)!=sz)
@@ -67,9 +67,10 @@ public:
   //! destructor
   ~MWAWInputStream();
 
-  //! returns the basic librevenge::RVNGInputStream
+  //! returns the basic librevenge::RVNGInputStream (positioned at the actual offset)
   shared_ptr<librevenge::RVNGInputStream> input()
   {
+    syncWindow();
     return m_stream;
   }
   //! returns a new input stream corresponding to a librevenge::RVNGBinaryData
@@ -95,7 +96,12 @@ public:
    */
   int seek(long offset, librevenge::RVNG_SEEK_TYPE seekType);
   //! returns actual offset position
-  long tell();
+  long tell()
+  {
+    if (m_window)
+      return m_windowOffset+long(m_windowPos);
+    return tellStream();
+  }
   //! returns the stream size
   long size() const
   {
@@ -136,10 +142,46 @@ public:
   //! returns a uint8, uint16, uint32 readed from actualPos
   unsigned long readULong(int num)
   {
-    return readULong(m_stream.get(), num, 0, m_inverseRead);
+    unsigned char const *p=m_window+m_windowPos;
+    switch (num) {
+    case 1:
+      if (m_windowPos>=m_windowSize) break;
+      ++m_windowPos;
+      return (unsigned long)p[0];
+    case 2:
+      if (m_windowPos+2>m_windowSize) break;
+      m_windowPos+=2;
+      if (m_inverseRead)
+        return (unsigned long)p[0]|((unsigned long)p[1]<<8);
+      return (unsigned long)p[1]|((unsigned long)p[0]<<8);
+    case 4:
+      if (m_windowPos+4>m_windowSize) break;
+      m_windowPos+=4;
+      if (m_inverseRead)
+        return (unsigned long)p[0]|((unsigned long)p[1]<<8)|((unsigned long)p[2]<<16)|((unsigned long)p[3]<<24);
+      return (unsigned long)p[3]|((unsigned long)p[2]<<8)|((unsigned long)p[1]<<16)|((unsigned long)p[0]<<24);
+    default:
+      break;
+    }
+    return readULongFromStream(num);
   }
   //! return a int8, int16, int32 readed from actualPos
-  long readLong(int num);
+  long readLong(int num)
+  {
+    switch (num) {
+    case 4:
+      return (long)(int32_t) readULong(4);
+    case 2:
+      return (long)(int16_t) readULong(2);
+    case 1:
+      return (long)(int8_t) readULong(1);
+    default:
+      break;
+    }
+    long v = long(readULong(num));
+    if ((v & long(0x1 << (num*8-1))) == 0) return v;
+    return v | long(0xFFFFFFFF << 8*num);
+  }
   //! try to read a double of size 8: 1.5 bytes exponent, 6.5 bytes mantisse
   bool readDouble8(double &res, bool &isNotANumber);
   //! try to read a double of size 8: 6.5 bytes mantisse, 1.5 bytes exponent
@@ -160,6 +202,12 @@ public:
   bool readDataBlock(long size, librevenge::RVNGBinaryData &data);
   //! reads a librevenge::RVNGBinaryData from actPos to the end of the section/file
   bool readEndDataBlock(librevenge::RVNGBinaryData &data);
+  /** looks for the first position between the actual position and endPos
+      (or the end of the section/file if endPos<0) where one of the patterns begins.
+      If found, seeks to this position and returns true; if not, seeks to endPos and returns false.
+
+      \note the patterns must begin before endPos but can end after it */
+  bool findNext(std::vector<std::string> const &patterns, long endPos=-1);
 
   //
   // OLE/Zip access
@@ -216,6 +264,37 @@ public:
 protected:
   //! update the stream size ( must be called in the constructor )
   void updateStreamSize();
+  //! returns the position of the basic stream
+  long tellStream();
+
+  //
+  // read window
+  //
+
+  /** tries to fill the read window from the actual position with at least minSize bytes.
+
+      \note if the basic stream keeps its data in memory, the window
+      contains all the data from the actual position to the end of stream
+
+      \note on success, the basic stream is positioned after the window */
+  bool fillWindow(unsigned long minSize);
+  //! forgets the read window and repositions the basic stream at the actual offset
+  void syncWindow()
+  {
+    if (!m_window) return;
+    long pos=m_windowOffset+long(m_windowPos);
+    resetWindow();
+    if (m_stream) m_stream->seek(pos, librevenge::RVNG_SEEK_SET);
+  }
+  //! forgets the read window without touching the basic stream (used when the basic stream is replaced)
+  void resetWindow()
+  {
+    m_window=0;
+    m_windowSize=m_windowPos=0;
+    m_windowOffset=0;
+  }
+  //! reads a number from the basic stream, filling the read window if possible
+  unsigned long readULongFromStream(int num);
   //! internal function used to read a byte
   static uint8_t readU8(librevenge::RVNGInputStream *stream);
 
@@ -248,6 +327,17 @@ protected:
   //! list of previous limits
   std::vector<long> m_prevLimits;
 
+  //! a flag to know if the basic stream data stay in memory until its destruction
+  bool m_isMemoryStream;
+  //! the read window: a part of the basic stream's buffer which begins at m_windowOffset
+  unsigned char const *m_window;
+  //! the read window size
+  unsigned long m_windowSize;
+  //! the actual position in the read window
+  unsigned long m_windowPos;
+  //! the file position corresponding to the beginning of the read window
+  long m_windowOffset;
+
   //! finder info type
   mutable std::string m_fInfoType;
   //! finder info type
@@ -101,6 +101,14 @@ public:
       \return the number of extra character read
    */
   virtual int insertCharacter(unsigned char c, MWAWInputStreamPtr &input, long endPos=-1)=0;
+  /** insert a run of characters using the font converter to find the
+      utf8 characters. The control characters (<0x20) are skipped, so the
+      run must be split at the tabs, the end of lines, ...
+
+      \return the number of characters used, ie. len excepted if the last
+      character needs a following character to be converted
+   */
+  virtual size_t insertCharacters(unsigned char const *str, size_t len)=0;
   /** adds an unicode character.
    *  By convention if \a character=0xfffd(undef), no character is added */
   virtual void insertUnicode(uint32_t character)=0;
@@ -164,35 +164,35 @@ int MWAWParagraph::cmp(MWAWParagraph const &para) const
     if (*(m_spacings[i]) > *(para.m_spacings[i])) return 1;
   }
   if (*m_justify < *para.m_justify) return -1;
-  if (*m_justify > *para.m_justify) return -1;
+  if (*m_justify > *para.m_justify) return 1;
   if (*m_marginsUnit < *para.m_marginsUnit) return -1;
-  if (*m_marginsUnit > *para.m_marginsUnit) return -1;
+  if (*m_marginsUnit > *para.m_marginsUnit) return 1;
   if (*m_spacingsInterlineUnit < *para.m_spacingsInterlineUnit) return -1;
-  if (*m_spacingsInterlineUnit > *para.m_spacingsInterlineUnit) return -1;
+  if (*m_spacingsInterlineUnit > *para.m_spacingsInterlineUnit) return 1;
   if (*m_spacingsInterlineType < *para.m_spacingsInterlineType) return -1;
-  if (*m_spacingsInterlineType > *para.m_spacingsInterlineType) return -1;
+  if (*m_spacingsInterlineType > *para.m_spacingsInterlineType) return 1;
   if (*m_tabsRelativeToLeftMargin < *para.m_tabsRelativeToLeftMargin) return -1;
-  if (*m_tabsRelativeToLeftMargin > *para.m_tabsRelativeToLeftMargin) return -1;
+  if (*m_tabsRelativeToLeftMargin > *para.m_tabsRelativeToLeftMargin) return 1;
 
   if (m_tabs->size() < para.m_tabs->size()) return -1;
-  if (m_tabs->size() > para.m_tabs->size()) return -1;
+  if (m_tabs->size() > para.m_tabs->size()) return 1;
 
   for (size_t i=0; i < m_tabs->size(); i++) {
     int diff=(*m_tabs)[i].cmp((*para.m_tabs)[i]);
     if (diff) return diff;
   }
   if (*m_breakStatus < *para.m_breakStatus) return -1;
-  if (*m_breakStatus > *para.m_breakStatus) return -1;
+  if (*m_breakStatus > *para.m_breakStatus) return 1;
   if (*m_listLevelIndex < *para.m_listLevelIndex) return -1;
-  if (*m_listLevelIndex > *para.m_listLevelIndex) return -1;
+  if (*m_listLevelIndex > *para.m_listLevelIndex) return 1;
   if (*m_listId < *para.m_listId) return -1;
-  if (*m_listId > *para.m_listId) return -1;
+  if (*m_listId > *para.m_listId) return 1;
   if (*m_listStartValue < *para.m_listStartValue) return -1;
-  if (*m_listStartValue > *para.m_listStartValue) return -1;
+  if (*m_listStartValue > *para.m_listStartValue) return 1;
   int diff=m_listLevel->cmp(*para.m_listLevel);
   if (diff) return diff;
   if (*m_backgroundColor < *para.m_backgroundColor) return -1;
-  if (*m_backgroundColor > *para.m_backgroundColor) return -1;
+  if (*m_backgroundColor > *para.m_backgroundColor) return 1;
 
   if (m_borders.size() < para.m_borders.size()) return -1;
   if (m_borders.size() > para.m_borders.size()) return 1;
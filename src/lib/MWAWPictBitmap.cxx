@@ -34,199 +34,300 @@
 /* This header contains code specific to some bitmap
  */
 
-#include <sstream>
 #include <string>
+#include <vector>
 
 #include <librevenge/librevenge.h>
 
+#ifdef USE_ZIP
+#  include <zlib.h>
+#endif
+
 #include "libmwaw_internal.hxx"
 
 #include "MWAWPictBitmap.hxx"
 
-//! Internal: helper function to create a PBM
+//! Internal: namespace used to define some internal function
+namespace MWAWPictBitmapInternal
+{
+//! Internal: the crc32 table used by the PNG encoder
+struct CRCTable {
+  //! constructor
+  CRCTable()
+  {
+    for (unsigned n=0; n<256; ++n) {
+      uint32_t c=uint32_t(n);
+      for (int k=0; k<8; ++k)
+        c = (c&1) ? uint32_t(0xedb88320L^(c>>1)) : (c>>1);
+      m_table[n]=c;
+    }
+  }
+  //! updates the crc of a set of bytes
+  uint32_t update(uint32_t crc, unsigned char const *buf, size_t len) const
+  {
+    uint32_t c=crc^0xffffffffL;
+    for (size_t n=0; n<len; ++n)
+      c=m_table[(c^buf[n])&0xff]^(c>>8);
+    return c^0xffffffffL;
+  }
+  //! the table
+  uint32_t m_table[256];
+};
+//! the crc32 table
+static CRCTable const s_crcTable;
+
+/** Internal: a small PNG encoder
+
+    \note the rows must be filled in the buffer given by getRow, the data are compressed
+    with zlib if it is available, if not, they are stored in uncompressed deflate blocks
+ */
+class PNGEncoder
+{
+public:
+  //! the PNG color type
+  enum ColorType { Gray=0, RGB=2, Palette=3, RGBA=6 };
+  //! constructor given the picture size, the color type and the bit depth
+  PNGEncoder(Vec2i const &sz, ColorType type, int bitDepth)
+    : m_size(sz), m_type(type), m_bitDepth(bitDepth), m_rowSize(0), m_raw(), m_palette()
+  {
+    int nComponents=type==RGB ? 3 : type==RGBA ? 4 : 1;
+    m_rowSize=size_t((m_size[0]*nComponents*bitDepth+7)/8);
+    // each row begins with the filter byte: 0
+    m_raw.resize(size_t(m_size[1])*(m_rowSize+1), 0);
+  }
+  //! returns the row data
+  unsigned char *getRow(int row)
+  {
+    return &m_raw[size_t(row)*(m_rowSize+1)+1];
+  }
+  //! sets the palette
+  void setPalette(std::vector<MWAWColor> const &palette)
+  {
+    m_palette=palette;
+  }
+  //! creates the PNG file
+  bool getData(librevenge::RVNGBinaryData &data) const
+  {
+    std::vector<unsigned char> res;
+    res.reserve(m_raw.size()/4+1024);
+    static unsigned char const signature[]= {0x89, 'P', 'N', 'G', 0x0d, 0x0a, 0x1a, 0x0a};
+    res.insert(res.end(), signature, signature+8);
+
+    std::vector<unsigned char> chunk;
+    writeU32(chunk, uint32_t(m_size[0]));
+    writeU32(chunk, uint32_t(m_size[1]));
+    chunk.push_back((unsigned char) m_bitDepth);
+    chunk.push_back((unsigned char) m_type);
+    chunk.push_back(0); // compression
+    chunk.push_back(0); // filter
+    chunk.push_back(0); // interlace
+    writeChunk(res, "IHDR", chunk);
+
+    if (m_type==Palette) {
+      chunk.clear();
+      bool hasAlpha=false;
+      for (size_t c=0; c<m_palette.size(); ++c) {
+        MWAWColor const &col=m_palette[c];
+        chunk.push_back(col.getRed());
+        chunk.push_back(col.getGreen());
+        chunk.push_back(col.getBlue());
+        if (col.getAlpha()!=255) hasAlpha=true;
+      }
+      writeChunk(res, "PLTE", chunk);
+      if (hasAlpha) {
+        chunk.clear();
+        for (size_t c=0; c<m_palette.size(); ++c)
+          chunk.push_back(m_palette[c].getAlpha());
+        writeChunk(res, "tRNS", chunk);
+      }
+    }
+
+    chunk.clear();
+    if (!compress(chunk)) return false;
+    writeChunk(res, "IDAT", chunk);
+    chunk.clear();
+    writeChunk(res, "IEND", chunk);
+
+    data.clear();
+    data.append(&res[0], (unsigned long) res.size());
+    return true;
+  }
+protected:
+  //! adds a big endian int32 value
+  static void writeU32(std::vector<unsigned char> &buffer, uint32_t value)
+  {
+    buffer.push_back((unsigned char)((value>>24)&0xFF));
+    buffer.push_back((unsigned char)((value>>16)&0xFF));
+    buffer.push_back((unsigned char)((value>>8)&0xFF));
+    buffer.push_back((unsigned char)(value&0xFF));
+  }
+  //! adds a chunk: length, type, data and crc
+  static void writeChunk(std::vector<unsigned char> &buffer, char const *type, std::vector<unsigned char> const &chunk)
+  {
+    writeU32(buffer, uint32_t(chunk.size()));
+    size_t pos=buffer.size();
+    buffer.insert(buffer.end(), type, type+4);
+    buffer.insert(buffer.end(), chunk.begin(), chunk.end());
+    writeU32(buffer, s_crcTable.update(0, &buffer[pos], buffer.size()-pos));
+  }
+  //! compresses the raw data in a zlib stream
+  bool compress(std::vector<unsigned char> &res) const
+  {
+#ifdef USE_ZIP
+    uLongf len=compressBound(uLong(m_raw.size()));
+    res.resize(size_t(len));
+    if (::compress2(&res[0], &len, &m_raw[0], uLong(m_raw.size()), Z_DEFAULT_COMPRESSION)!=Z_OK) {
+      MWAW_DEBUG_MSG(("MWAWPictBitmapInternal::PNGEncoder::compress: can not compress the data\n"));
+      return false;
+    }
+    res.resize(size_t(len));
+#else
+    // no zlib, store the data in uncompressed blocks
+    size_t const numData=m_raw.size();
+    res.reserve(numData+5*(numData/0xFFFF+1)+6);
+    res.push_back(0x78);
+    res.push_back(0x01);
+    size_t pos=0;
+    do {
+      size_t len=numData-pos;
+      if (len>0xFFFF) len=0xFFFF;
+      res.push_back(pos+len==numData ? 1 : 0);
+      res.push_back((unsigned char)(len&0xFF));
+      res.push_back((unsigned char)(len>>8));
+      res.push_back((unsigned char)(~len&0xFF));
+      res.push_back((unsigned char)((~len>>8)&0xFF));
+      res.insert(res.end(), m_raw.begin()+long(pos), m_raw.begin()+long(pos+len));
+      pos+=len;
+    }
+    while (pos<numData);
+    // the adler32 checksum
+    uint32_t s1=1, s2=0;
+    for (size_t i=0; i<numData; ++i) {
+      s1=(s1+m_raw[i])%65521;
+      s2=(s2+s1)%65521;
+    }
+    writeU32(res, (s2<<16)|s1);
+#endif
+    return true;
+  }
+  //! the picture size
+  Vec2i m_size;
+  //! the color type
+  ColorType m_type;
+  //! the bit depth
+  int m_bitDepth;
+  //! the row size (without the filter byte)
+  size_t m_rowSize;
+  //! the raw data: for each row, the filter byte followed by the row data
+  std::vector<unsigned char> m_raw;
+  //! the palette
+  std::vector<MWAWColor> m_palette;
+};
+
+//! Internal: helper function to create a 1-bit gray PNG
 template <class T>
-bool getPBMData(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryData &data, T white)
+static bool getPNGBWData(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryData &data, T white)
 {
   Vec2i sz = orig.size();
   if (sz[0] <= 0 || sz[1] <= 0) return false;
 
-  data.clear();
-  std::stringstream f;
-  f << "P4\n" << sz[0] << " " << sz[1] << "\n";
-  std::string const &header = f.str();
-  data.append((const unsigned char *)header.c_str(), header.size());
-
+  PNGEncoder png(sz, PNGEncoder::Gray, 1);
   for (int j = 0; j < sz[1]; j++) {
     T const *row = orig.getRow(j);
-
-    unsigned char mask = 0x80, value = 0;
+    unsigned char *out = png.getRow(j);
     for (int i = 0; i < sz[0]; i++) {
-      if (row[i] != white) value |= mask;
-      mask = (unsigned char)(mask >> 1);
-      if (mask != 0) continue;
-      data.append(value);
-      value = 0;
-      mask = 0x80;
+      if (row[i] == white) out[i>>3] = (unsigned char)(out[i>>3] | (0x80>>(i&7)));
     }
-    if (mask!= 0x80) data.append(value);
   }
-  return true;
+  return png.getData(data);
 }
 
-//! Internal: helper function to create a PPM
+//! Internal: helper function to create a 1-bit gray PNG from packed rows (a bit set meaning black)
+static bool getPNGBWData(MWAWPictBitmapContainerBool const &orig, librevenge::RVNGBinaryData &data)
+{
+  Vec2i sz = orig.size();
+  if (sz[0] <= 0 || sz[1] <= 0) return false;
+
+  PNGEncoder png(sz, PNGEncoder::Gray, 1);
+  int const rowSize=orig.getRowSize();
+  for (int j = 0; j < sz[1]; j++) {
+    unsigned char const *row = orig.getRowPacked(j);
+    unsigned char *out = png.getRow(j);
+    for (int i = 0; i < rowSize; i++)
+      out[i] = (unsigned char) ~row[i];
+  }
+  return png.getData(data);
+}
+
+//! Internal: helper function to create a palette PNG
 template <class T>
-bool getPPMData(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryData &data, std::vector<MWAWColor> const &indexedColor)
+static bool getPNGIndexedData(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryData &data, std::vector<MWAWColor> const &indexedColor)
 {
   Vec2i sz = orig.size();
   if (sz[0] <= 0 || sz[1] <= 0) return false;
 
   int nColors = int(indexedColor.size());
-
-  data.clear();
-  std::stringstream f;
-  f << "P6\n" << sz[0] << " " << sz[1] << " 255\n";
-  std::string const &header = f.str();
-  data.append((const unsigned char *)header.c_str(), header.size());
+  if (nColors <= 0) return false;
+  bool usePalette = nColors <= 256;
+  int bitDepth = !usePalette ? 8 : nColors <= 2 ? 1 : nColors <= 4 ? 2 : nColors <= 16 ? 4 : 8;
+  PNGEncoder png(sz, usePalette ? PNGEncoder::Palette : PNGEncoder::RGB, bitDepth);
+  if (usePalette) png.setPalette(indexedColor);
+  int const pixelsByByte=8/bitDepth;
   for (int j = 0; j < sz[1]; j++) {
     T const *row = orig.getRow(j);
-
+    unsigned char *out = png.getRow(j);
     for (int i = 0; i < sz[0]; i++) {
       int ind = row[i];
       if (ind < 0 || ind >= nColors) {
-        MWAW_DEBUG_MSG(("MWAWPictBitmap::getPPMData invalid index %d\n", ind));
+        MWAW_DEBUG_MSG(("MWAWPictBitmap::getPNGIndexedData invalid index %d\n", ind));
         return false;
       }
-      uint32_t col = indexedColor[size_t(ind)].value();
-      for (int c = 0, depl=16; c < 3; c++, depl-=8)
-        data.append((unsigned char)((col>>depl)&0xFF));
+      if (!usePalette) {
+        MWAWColor const &col=indexedColor[size_t(ind)];
+        *(out++)=col.getRed();
+        *(out++)=col.getGreen();
+        *(out++)=col.getBlue();
+      }
+      else if (bitDepth==8)
+        out[i]=(unsigned char) ind;
+      else {
+        int shift=8-bitDepth*(i%pixelsByByte+1);
+        out[i/pixelsByByte] = (unsigned char)(out[i/pixelsByByte] | (ind<<shift));
+      }
     }
   }
-  return true;
+  return png.getData(data);
 }
 
-//! Internal: namespace used to define some internal function
-namespace MWAWPictBitmapInternal
-{
-//! Internal: helper function to create a PPM for a color bitmap
-static bool getPPMData(MWAWPictBitmapContainer<MWAWColor> const &orig, librevenge::RVNGBinaryData &data)
+//! Internal: helper function to create a RGB or a RGBA PNG for a color bitmap
+static bool getPNGColorData(MWAWPictBitmapContainer<MWAWColor> const &orig, librevenge::RVNGBinaryData &data, bool hasAlpha)
 {
   Vec2i sz = orig.size();
   if (sz[0] <= 0 || sz[1] <= 0) return false;
 
-  data.clear();
-  std::stringstream f;
-  f << "P6\n" << sz[0] << " " << sz[1] << " 255\n";
-  std::string const &header = f.str();
-  data.append((const unsigned char *)header.c_str(), header.size());
+  PNGEncoder png(sz, hasAlpha ? PNGEncoder::RGBA : PNGEncoder::RGB, 8);
   for (int j = 0; j < sz[1]; j++) {
     MWAWColor const *row = orig.getRow(j);
-
+    unsigned char *out = png.getRow(j);
     for (int i = 0; i < sz[0]; i++) {
       uint32_t col = row[i].value();
-      for (int c = 0, depl=16; c < 3; c++, depl-=8)
-        data.append((unsigned char)((col>>depl)&0xFF));
+      *(out++)=(unsigned char)((col>>16)&0xFF);
+      *(out++)=(unsigned char)((col>>8)&0xFF);
+      *(out++)=(unsigned char)(col&0xFF);
+      if (hasAlpha) *(out++)=(unsigned char)((col>>24)&0xFF);
     }
   }
-  return true;
+  return png.getData(data);
 }
-
-//
-// functions used by getPBMData (freely inspired from libpwg::WPGBitmap.cpp)
-//
-static void writeU16(unsigned char *buffer, unsigned &position, const unsigned value)
-{
-  buffer[position++] = (unsigned char)(value & 0xFF);
-  buffer[position++] = (unsigned char)((value >> 8) & 0xFF);
 }
 
-static void writeU32(unsigned char *buffer, unsigned &position, const unsigned value)
-{
-  buffer[position++] = (unsigned char)(value & 0xFF);
-  buffer[position++] = (unsigned char)((value >> 8) & 0xFF);
-  buffer[position++] = (unsigned char)((value >> 16) & 0xFF);
-  buffer[position++] = (unsigned char)((value >> 24) & 0xFF);
-}
-
-//! Internal: helper function to create a BMP for a color bitmap (freely inspired from libpwg::WPGBitmap.cpp)
-static bool getBMPData(MWAWPictBitmapContainer<MWAWColor> const &orig, librevenge::RVNGBinaryData &data)
-{
-  Vec2i sz = orig.size();
-  if (sz[0] <= 0 || sz[1] <= 0) return false;
-
-  unsigned tmpPixelSize = unsigned(sz[0]*sz[1]);
-  unsigned tmpBufferPosition = 0;
-
-  unsigned tmpDIBImageSize = tmpPixelSize * 4;
-  if (tmpPixelSize > tmpDIBImageSize) // overflow !!!
-    return false;
-
-  unsigned const headerSize=56;
-  unsigned tmpDIBOffsetBits = 14 + headerSize;
-  unsigned tmpDIBFileSize = tmpDIBOffsetBits + tmpDIBImageSize;
-  if (tmpDIBImageSize > tmpDIBFileSize) // overflow !!!
-    return false;
-
-  unsigned char *tmpDIBBuffer = new unsigned char[tmpDIBFileSize];
-  if (!tmpDIBBuffer) {
-    MWAW_DEBUG_MSG(("getBMPData: fail to allocated the data buffer\n"));
-    return false;
-  }
-  // Create DIB file header
-  writeU16(tmpDIBBuffer, tmpBufferPosition, 0x4D42);  // Type
-  writeU32(tmpDIBBuffer, tmpBufferPosition, (unsigned) tmpDIBFileSize); // Size
-  writeU16(tmpDIBBuffer, tmpBufferPosition, 0); // Reserved1
-  writeU16(tmpDIBBuffer, tmpBufferPosition, 0); // Reserved2
-  writeU32(tmpDIBBuffer, tmpBufferPosition, (unsigned) tmpDIBOffsetBits); // OffsetBits
-
-  // Create DIB Info header
-  writeU32(tmpDIBBuffer, tmpBufferPosition, headerSize); // Size
-  writeU32(tmpDIBBuffer, tmpBufferPosition, (unsigned) sz[0]);  // Width
-  writeU32(tmpDIBBuffer, tmpBufferPosition, (unsigned) sz[1]); // Height
-  writeU16(tmpDIBBuffer, tmpBufferPosition, 1); // Planes
-  writeU16(tmpDIBBuffer, tmpBufferPosition, 32); // BitCount
-  writeU32(tmpDIBBuffer, tmpBufferPosition, 0); // Compression
-  writeU32(tmpDIBBuffer, tmpBufferPosition, (unsigned)tmpDIBImageSize); // SizeImage
-  writeU32(tmpDIBBuffer, tmpBufferPosition, 5904); // XPelsPerMeter: 300ppi
-  writeU32(tmpDIBBuffer, tmpBufferPosition, 5904); // YPelsPerMeter: 300ppi
-  writeU32(tmpDIBBuffer, tmpBufferPosition, 0); // ColorsUsed
-  writeU32(tmpDIBBuffer, tmpBufferPosition, 0); // ColorsImportant
-
-  // Create DIB V3 Info header
-
-  /* this is needed to create alpha picture ; but as both LibreOffice/OpenOffice ignore the alpha channel... */
-  writeU32(tmpDIBBuffer, tmpBufferPosition, 0x00FF0000); /* biRedMask */
-  writeU32(tmpDIBBuffer, tmpBufferPosition, 0x0000FF00); /* biGreenMask */
-  writeU32(tmpDIBBuffer, tmpBufferPosition, 0x000000FF); /* biBlueMask */
-  writeU32(tmpDIBBuffer, tmpBufferPosition, 0xFF000000); /* biAlphaMask */
-
-  // Write DIB Image data
-  for (int i = sz[1] - 1; i >= 0 && tmpBufferPosition < tmpDIBFileSize; i--) {
-    MWAWColor const *row = orig.getRow(i);
-
-    for (int j = 0; j < sz[0] && tmpBufferPosition < tmpDIBFileSize; j++) {
-      uint32_t col = row[j].value();
-
-      tmpDIBBuffer[tmpBufferPosition++]=(unsigned char)(col&0xFF);
-      tmpDIBBuffer[tmpBufferPosition++]=(unsigned char)((col>>8)&0xFF);
-      tmpDIBBuffer[tmpBufferPosition++]=(unsigned char)((col>>16)&0xFF);
-      tmpDIBBuffer[tmpBufferPosition++]=(unsigned char)((col>>24)&0xFF);
-    }
-  }
-  data.clear();
-  data.append(tmpDIBBuffer, tmpDIBFileSize);
-  // Cleanup things before returning
-  delete [] tmpDIBBuffer;
-
-  return true;
-}
-}
 ////////////////////////////////////////////////////////////
 // BW bitmap
 ////////////////////////////////////////////////////////////
 
 bool MWAWPictBitmapBW::createFileData(librevenge::RVNGBinaryData &result) const
 {
-  return getPBMData<bool>(m_data,result,false);
+  return MWAWPictBitmapInternal::getPNGBWData(m_data,result);
 }
 
 ////////////////////////////////////////////////////////////
@@ -235,8 +336,7 @@ bool MWAWPictBitmapBW::createFileData(librevenge::RVNGBinaryData &result) const
 
 bool MWAWPictBitmapColor::createFileData(librevenge::RVNGBinaryData &result) const
 {
-  if (m_hasAlpha) return MWAWPictBitmapInternal::getBMPData(m_data,result);
-  return MWAWPictBitmapInternal::getPPMData(m_data,result);
+  return MWAWPictBitmapInternal::getPNGColorData(m_data,result,m_hasAlpha);
 }
 
 ////////////////////////////////////////////////////////////
@@ -245,7 +345,11 @@ bool MWAWPictBitmapColor::createFileData(librevenge::RVNGBinaryData &result) con
 
 bool MWAWPictBitmapIndexed::createFileData(librevenge::RVNGBinaryData &result) const
 {
-  if (m_colors.size() && getPPMData<int>(m_data,result,m_colors)) return true;
-  return getPBMData<int>(m_data,result,0);
+  if (m_data.hasInvalidIndex()) {
+    MWAW_DEBUG_MSG(("MWAWPictBitmapIndexed::createFileData: find some invalid index\n"));
+  }
+  else if (m_colors.size() && MWAWPictBitmapInternal::getPNGIndexedData<unsigned char>(m_data,result,m_colors))
+    return true;
+  return MWAWPictBitmapInternal::getPNGBWData<unsigned char>(m_data,result,0);
 }
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
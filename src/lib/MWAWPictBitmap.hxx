@@ -38,7 +38,9 @@
 #  define MWAW_PICT_BITMAP
 
 #include <assert.h>
+#include <string.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "libmwaw_internal.hxx"
@@ -148,40 +150,191 @@ protected:
   T *m_data;
 };
 
-//! a bool container with a function to put packed row
-class MWAWPictBitmapContainerBool : public MWAWPictBitmapContainer<bool>
+/** \brief a container to store a 2D array of bool
+ *
+ * \note the data are stored by packed rows: 8 pixels by byte, the first pixel being
+ * stored in the high bit */
+class MWAWPictBitmapContainerBool
 {
 public:
   //! constructor
-  MWAWPictBitmapContainerBool(Vec2i const &sz) : MWAWPictBitmapContainer<bool>(sz) {}
+  MWAWPictBitmapContainerBool(Vec2i const &sz) : m_size(sz), m_rowSize(0), m_data()
+  {
+    if (m_size[0] <= 0 || m_size[1] <= 0) return;
+    m_rowSize = (m_size[0]+7)/8;
+    m_data.resize(size_t(m_rowSize*m_size[1]), 0);
+  }
+  //! returns ok, if the m_data is allocated
+  bool ok() const
+  {
+    return !m_data.empty();
+  }
 
   //! a comparison operator
   int cmp(MWAWPictBitmapContainerBool const &orig) const
   {
     int diff = m_size.cmpY(orig.m_size);
     if (diff) return diff;
-    if (!m_data) return orig.m_data ? 1 : 0;
-    if (!orig.m_data) return -1;
-    for (int i=0; i < m_size[0]*m_size[1]; i++) {
-      if (m_data[i] == orig.m_data[i]) continue;
-      return m_data[i] ? 1 : -1;
-    }
+    if (m_data.empty()) return orig.m_data.empty() ? 0 : 1;
+    if (orig.m_data.empty()) return -1;
+    diff = memcmp(&m_data[0], &orig.m_data[0], m_data.size());
+    if (diff) return diff < 0 ? -1 : 1;
     return 0;
   }
+  //! return the array size
+  Vec2i const &size() const
+  {
+    return m_size;
+  }
+  //! gets the number of row
+  int numRows() const
+  {
+    return m_size[0];
+  }
+  //! gets the number of column
+  int numColumns() const
+  {
+    return m_size[1];
+  }
+  //! returns the number of bytes used to store a row
+  int getRowSize() const
+  {
+    return m_rowSize;
+  }
+
+  //! accessor of a cell m_data
+  bool get(int i, int j) const
+  {
+    assert(ok() && i>=0 && i < m_size[0] && j>=0 && j < m_size[1]);
+    return (m_data[size_t(j*m_rowSize+i/8)]&(0x80>>(i%8))) != 0;
+  }
+  //! accessor of a packed row m_data
+  unsigned char const *getRowPacked(int j) const
+  {
+    assert(ok() && j>=0 && j < m_size[1]);
+    return &m_data[size_t(j*m_rowSize)];
+  }
 
+  //! sets a cell m_data
+  void set(int i, int j, bool v)
+  {
+    assert(ok() && i>=0 && i < m_size[0] && j>=0 && j < m_size[1]);
+    unsigned char &c = m_data[size_t(j*m_rowSize+i/8)];
+    unsigned char mask = (unsigned char)(0x80>>(i%8));
+    c = (unsigned char)(v ? (c|mask) : (c&~mask));
+  }
+  //! sets a line of m_data
+  void setRow(int j, bool const *val)
+  {
+    assert(ok() && j>=0 && j < m_size[1]);
+    unsigned char *row = &m_data[size_t(j*m_rowSize)];
+    std::fill_n(row, m_rowSize, (unsigned char) 0);
+    for (int i = 0; i < m_size[0]; i++) {
+      if (val[i]) row[i/8] = (unsigned char)(row[i/8] | (0x80>>(i%8)));
+    }
+  }
   //! allows to use packed m_data
   void setRowPacked(int j, unsigned char const *val)
+  {
+    assert(ok() && j>=0 && j < m_size[1]);
+    unsigned char *row = &m_data[size_t(j*m_rowSize)];
+    std::copy(val, val+m_rowSize, row);
+    // reset the unused bits
+    if (m_size[0]%8)
+      row[m_rowSize-1] = (unsigned char)(row[m_rowSize-1] & (0xFF00>>(m_size[0]%8)));
+  }
+  //! sets a column of m_data
+  void setColumn(int i, bool const *val)
+  {
+    assert(ok() && i>=0 && i < m_size[0]);
+    for (int j = 0; j < m_size[1]; j++) set(i, j, val[j]);
+  }
+
+protected:
+  //! the size
+  Vec2i m_size;
+  //! the number of bytes by row
+  int m_rowSize;
+  //! the packed rows
+  std::vector<unsigned char> m_data;
+};
+
+/** \brief a container to store a 2D array of color indices
+ *
+ * \note the indices are stored in a byte, so only the first 256 colors
+ * of a palette can be used; setting an index outside [0,255] marks the
+ * container as invalid */
+class MWAWPictBitmapContainerIndex : public MWAWPictBitmapContainer<unsigned char>
+{
+public:
+  //! constructor
+  MWAWPictBitmapContainerIndex(Vec2i const &sz) : MWAWPictBitmapContainer<unsigned char>(sz), m_hasInvalidIndex(false) {}
+  //! returns true if an index outside [0,255] has been set
+  bool hasInvalidIndex() const
+  {
+    return m_hasInvalidIndex;
+  }
+
+  //! sets a cell m_data
+  void set(int i, int j, int v)
+  {
+    MWAWPictBitmapContainer<unsigned char>::set(i, j, toIndex(v));
+  }
+  //! sets a line of m_data
+  template <class U>
+  void setRow(int j, U const *val)
+  {
+    assert(m_data != 0L && j>=0 && j < m_size[1]);
+    unsigned char *row = m_data+m_size[0]*j;
+    for (int i = 0; i < m_size[0]; i++) row[i] = toIndex(int(val[i]));
+  }
+  //! sets a line of m_data given a line of byte
+  void setRow(int j, unsigned char const *val)
   {
     assert(m_data != 0L && j>=0 && j < m_size[1]);
-    for (int i = 0, ind = j*m_size[0]; i < m_size[0];) {
-      unsigned char v = *(val++);
-      unsigned char mask = 0x80;
-      for (int p = 0; p < 8 && i < m_size[0]; i++, p++, ind++) {
-        m_data[ind] = ((v&mask) != 0);
-        mask = (unsigned char)(mask >> 1);
+    std::copy(val, val+m_size[0], m_data+m_size[0]*j);
+  }
+  /** sets a line of m_data given a packed line of indices: numBits must be 1, 2, 4 or 8,
+      the first index is stored in the high bits */
+  void setRowPacked(int j, unsigned char const *val, int numBits=1)
+  {
+    assert(m_data != 0L && j>=0 && j < m_size[1]);
+    if (numBits==8) {
+      setRow(j, val);
+      return;
+    }
+    if (numBits!=1 && numBits!=2 && numBits!=4) {
+      MWAW_DEBUG_MSG(("MWAWPictBitmapContainerIndex::setRowPacked: unexpected number of bits %d\n", numBits));
+      return;
+    }
+    unsigned char *row = m_data+m_size[0]*j;
+    int const mask=(1<<numBits)-1;
+    for (int i = 0, depl=8; i < m_size[0]; i++) {
+      depl-=numBits;
+      row[i] = (unsigned char)(((*val)>>depl)&mask);
+      if (depl==0) {
+        depl=8;
+        ++val;
       }
     }
   }
+  //! sets a column of m_data
+  template <class U>
+  void setColumn(int i, U const *val)
+  {
+    assert(m_data != 0L && i>=0 && i < m_size[0]);
+    for (int j = 0; j < m_size[1]; j++) m_data[i+j*m_size[0]] = toIndex(int(val[j]));
+  }
+protected:
+  //! converts a value in an index, remembers if the value is invalid
+  unsigned char toIndex(int v)
+  {
+    if (v>=0 && v<=255) return (unsigned char) v;
+    m_hasInvalidIndex=true;
+    return (unsigned char) 255;
+  }
+  //! a flag to know if an invalid index has been set
+  bool m_hasInvalidIndex;
 };
 
 //! Generic class used to construct bitmap
@@ -203,9 +356,8 @@ public:
   {
     if (!valid()) return false;
 
-    s = "image/pict";
-    createFileData(res);
-    return true;
+    s = "image/png";
+    return createFileData(res);
   }
 
   //! returns true if the picture is valid
@@ -240,7 +392,7 @@ protected:
   }
 };
 
-/** a bitmap of bool to store black-white bitmap */
+/** a bitmap of bool to store black-white bitmap (stored by packed rows) */
 class MWAWPictBitmapBW : public MWAWPictBitmap
 {
 public:
@@ -290,10 +442,10 @@ public:
   {
     return m_data.get(i,j);
   }
-  //! returns the cells content of a row
-  bool const *getRow(int j) const
+  //! returns the cells content of a row: 8 cells by byte
+  unsigned char const *getRowPacked(int j) const
   {
-    return m_data.getRow(j);
+    return m_data.getRowPacked(j);
   }
   //! sets a cell contents
   void set(int i, int j, bool v)
@@ -324,7 +476,7 @@ protected:
   MWAWPictBitmapContainerBool m_data;
 };
 
-/** a bitmap of int to store indexed bitmap */
+/** a bitmap of byte to store indexed bitmap */
 class MWAWPictBitmapIndexed : public MWAWPictBitmap
 {
 public:
@@ -383,7 +535,7 @@ public:
     return m_data.get(i,j);
   }
   //! returns the cells content of a row
-  int const *getRow(int j) const
+  unsigned char const *getRow(int j) const
   {
     return m_data.getRow(j);
   }
@@ -398,6 +550,11 @@ public:
   {
     m_data.setRow(j, val);
   }
+  //! sets all cell contents of a row given packed indices (numBits must be 1, 2, 4 or 8)
+  void setRowPacked(int j, unsigned char const *val, int numBits=1)
+  {
+    m_data.setRowPacked(j, val, numBits);
+  }
   //! sets all cell contents of a column
   template <class U> void setColumn(int i, U const *val)
   {
@@ -420,7 +577,7 @@ protected:
   virtual bool createFileData(librevenge::RVNGBinaryData &result) const;
 
   //! the m_data
-  MWAWPictBitmapContainer<int> m_data;
+  MWAWPictBitmapContainerIndex m_data;
   //! the colors
   std::vector<MWAWColor> m_colors;
 };
@@ -339,35 +339,19 @@ struct Bitmap {
 
     static int ppmNumber = 0;
     std::stringstream f;
-    f << "PictBitmap" << ppmNumber++ << ".pbm";
+    f << "PictBitmap" << ppmNumber++ << ".png";
     return libmwaw::Debug::dumpFile(dt, f.str().c_str());
   }
 
   //! creates the bitmap from the packdata
   bool unpackedData(unsigned char const *pData, int sz)
   {
-    int rPos = 0;
-    size_t wPos = m_bitmap.size(), wNPos = wPos+size_t(m_rowBytes);
-    m_bitmap.resize(size_t(wNPos));
-
-    while (rPos < sz) {
-      if (rPos+2 > sz) return false;
-      signed char n = (signed char) pData[rPos++];
-      if (n < 0) {
-        int nCount = 1-n;
-        if (wPos+size_t(nCount) > wNPos) return false;
-
-        unsigned char val = pData[rPos++];
-        for (int i = 0; i < nCount; i++)
-          m_bitmap[wPos++] = val;
-        continue;
-      }
-      int nCount = 1+n;
-      if (rPos+nCount > sz || wPos+size_t(nCount) > wNPos) return false;
-      for (int i = 0; i < nCount; i++)
-        m_bitmap[wPos++] = pData[rPos++];
-    }
-    return (wPos == wNPos);
+    if (m_rowBytes <= 0) return sz==0;
+    size_t wPos = m_bitmap.size();
+    m_bitmap.resize(wPos+size_t(m_rowBytes));
+    libmwaw::PackBitsDecoder decoder(1, true);
+    return decoder.decode(pData, (unsigned long) sz, &m_bitmap[wPos], (unsigned long) m_rowBytes, true) &&
+           decoder.getNumWritten()==(unsigned long) m_rowBytes;
   }
 
   //! parses the bitmap data zone
@@ -620,7 +604,7 @@ struct Pixmap {
 
       static int ppmNumber = 0;
       std::stringstream f;
-      f << "PictPixmap" << ppmNumber++ << ".ppm";
+      f << "PictPixmap" << ppmNumber++ << ".png";
       return libmwaw::Debug::dumpFile(dt, f.str().c_str());
     }
     else if (m_colors.size()) {
@@ -640,7 +624,7 @@ struct Pixmap {
 
       static int ppmNumber = 0;
       std::stringstream f;
-      f << "PictDirect" << ppmNumber++ << ".ppm";
+      f << "PictDirect" << ppmNumber++ << ".png";
       return libmwaw::Debug::dumpFile(dt, f.str().c_str());
 
     }
@@ -656,30 +640,11 @@ struct Pixmap {
   bool unpackedData(unsigned char const *pData, int sz, int byteSz, int nSize, std::vector<unsigned char> &res) const
   {
     assert(byteSz >= 1 && byteSz <= 4);
-    int rPos = 0, wPos = 0, maxW = m_rowBytes+24;
-    while (rPos < sz) {
-      if (rPos+2 > sz) return false;
-      signed char n = (signed char) pData[rPos++];
-      if (n < 0) {
-        int nCount = 1-n;
-        if (rPos+byteSz > sz || wPos+byteSz *nCount >= maxW) return false;
-
-        unsigned char val[4];
-        for (int b = 0; b < byteSz; b++) val[b] = pData[rPos++];
-        for (int i = 0; i < nCount; i++) {
-          if (wPos+byteSz >= maxW) break;
-          for (int b = 0; b < byteSz; b++)res[(size_t)wPos++] = val[b];
-        }
-        continue;
-      }
-      int nCount = 1+n;
-      if (rPos+byteSz *nCount > sz || wPos+byteSz *nCount >= maxW) return false;
-      for (int i = 0; i < nCount; i++) {
-        if (wPos+byteSz >= maxW) break;
-        for (int b = 0; b < byteSz; b++) res[(size_t)wPos++] = pData[rPos++];
-      }
-    }
-    return wPos >= nSize;
+    // res is big enough to contain m_rowBytes+24 bytes, but we keep one byte at the end
+    if (res.size() < size_t(m_rowBytes+23)) return false;
+    libmwaw::PackBitsDecoder decoder(byteSz, true);
+    return decoder.decode(pData, (unsigned long) sz, &res[0], (unsigned long)(m_rowBytes+23), true) &&
+           decoder.getNumWritten()>=(unsigned long) nSize;
   }
 
   //! parses the pixmap data zone
@@ -33,11 +33,10 @@
 
 /* This header contains code specific to a small picture
  */
-#include <iostream>
-#include <sstream>
+#include <stdio.h>
 #include <string.h>
 
-#include <stack>
+#include <deque>
 
 #include "libmwaw_internal.hxx"
 
@@ -53,77 +52,141 @@
 //
 ////////////////////////////////////////////////////
 MWAWPropertyHandlerEncoder::MWAWPropertyHandlerEncoder()
-  : m_f(std::ios::in | std::ios::out | std::ios::binary)
+  : m_data(), m_nameIdMap()
 {
+  m_data.reserve(1024);
+  writeChar('V');
+  writeULong(2);
 }
 
 void MWAWPropertyHandlerEncoder::insertElement(const char *psName)
 {
-  m_f << 'E';
-  writeString(psName);
+  writeChar('E');
+  writeName(psName);
 }
 
 void MWAWPropertyHandlerEncoder::insertElement
 (const char *psName, const librevenge::RVNGPropertyList &xPropList)
 {
-  m_f << 'S';
-  writeString(psName);
+  writeChar('S');
+  writeName(psName);
   writePropertyList(xPropList);
 }
 
 void MWAWPropertyHandlerEncoder::characters(librevenge::RVNGString const &sCharacters)
 {
   if (sCharacters.len()==0) return;
-  m_f << 'T';
+  writeChar('T');
   writeString(sCharacters);
 }
 
 void MWAWPropertyHandlerEncoder::writeString(const librevenge::RVNGString &string)
 {
   unsigned long sz = string.size()+1;
-  writeLong((long) sz);
-  m_f.write(string.cstr(), (int) sz);
+  writeULong(sz);
+  unsigned char const *ptr=(unsigned char const *) string.cstr();
+  m_data.insert(m_data.end(), ptr, ptr+sz);
+}
+
+void MWAWPropertyHandlerEncoder::writeName(const char *name)
+{
+  std::string key(name ? name : "");
+  std::map<std::string, unsigned long>::const_iterator it=m_nameIdMap.find(key);
+  if (it!=m_nameIdMap.end()) {
+    writeULong(it->second+1);
+    return;
+  }
+  unsigned long id=(unsigned long) m_nameIdMap.size();
+  m_nameIdMap[key]=id;
+  writeULong(0);
+  writeString(key.c_str());
+}
+
+void MWAWPropertyHandlerEncoder::writeULong(unsigned long val)
+{
+  while (val>=0x80) {
+    m_data.push_back((unsigned char)(0x80|(val&0x7F)));
+    val>>=7;
+  }
+  m_data.push_back((unsigned char) val);
 }
 
 void MWAWPropertyHandlerEncoder::writeLong(long val)
 {
   int32_t value=(int32_t) val;
-  unsigned char const allValue[]= {(unsigned char)(value&0xFF), (unsigned char)((value>>8)&0xFF), (unsigned char)((value>>16)&0xFF), (unsigned char)((value>>24)&0xFF)};
-  m_f.write((const char *)allValue, 4);
+  m_data.push_back((unsigned char)(value&0xFF));
+  m_data.push_back((unsigned char)((value>>8)&0xFF));
+  m_data.push_back((unsigned char)((value>>16)&0xFF));
+  m_data.push_back((unsigned char)((value>>24)&0xFF));
+}
+
+void MWAWPropertyHandlerEncoder::writeDouble(double val)
+{
+  uint64_t value;
+  memcpy(&value, &val, 8);
+  for (int i=0; i<8; ++i, value>>=8)
+    m_data.push_back((unsigned char)(value&0xFF));
 }
 
-void MWAWPropertyHandlerEncoder::writeProperty(const char *key, const librevenge::RVNGProperty &prop)
+void MWAWPropertyHandlerEncoder::writeProperty(const librevenge::RVNGProperty &prop)
 {
-  if (!key) {
-    MWAW_DEBUG_MSG(("MWAWPropertyHandlerEncoder::writeProperty: key is NULL\n"));
+  librevenge::RVNGUnit unit=prop.getUnit();
+  switch (unit) {
+  case librevenge::RVNG_INCH:
+  case librevenge::RVNG_PERCENT:
+  case librevenge::RVNG_POINT:
+  case librevenge::RVNG_TWIP:
+    writeChar('d');
+    writeChar((char) unit);
+    writeDouble(prop.getDouble());
     return;
+  case librevenge::RVNG_GENERIC:
+  case librevenge::RVNG_UNIT_ERROR:
+  default:
+    break;
   }
-  writeString(key);
-  writeString(prop.getStr());
+  librevenge::RVNGString str=prop.getStr();
+  if (unit==librevenge::RVNG_GENERIC && str.len()>0 && str.len()<12) {
+    // check if the value is an integer, ie. if it can be retrieved from getInt
+    int val=prop.getInt();
+    char buffer[20];
+    sprintf(buffer, "%d", val);
+    if (strcmp(buffer, str.cstr())==0) {
+      writeChar('i');
+      writeLong(val);
+      return;
+    }
+  }
+  writeChar('s');
+  writeString(str);
 }
 
 void MWAWPropertyHandlerEncoder::writePropertyList(const librevenge::RVNGPropertyList &xPropList)
 {
   librevenge::RVNGPropertyList::Iter i(xPropList);
-  long numElt = 0;
+  unsigned long numElt = 0;
   for (i.rewind(); i.next();) numElt++;
-  writeLong(numElt);
+  writeULong(numElt);
   for (i.rewind(); i.next();) {
     librevenge::RVNGPropertyListVector const *child=xPropList.child(i.key());
     if (!child) {
-      m_f << 'p';
-      writeProperty(i.key(),*i());
+      if (!i.key()) {
+        MWAW_DEBUG_MSG(("MWAWPropertyHandlerEncoder::writePropertyList: key is NULL\n"));
+      }
+      writeChar('p');
+      writeName(i.key());
+      writeProperty(*i());
       continue;
     }
-    m_f << 'v';
-    writeString(i.key());
+    writeChar('v');
+    writeName(i.key());
     writePropertyListVector(*child);
   }
 }
 
 void MWAWPropertyHandlerEncoder::writePropertyListVector(const librevenge::RVNGPropertyListVector &vect)
 {
-  writeLong((long)vect.count());
+  writeULong((unsigned long)vect.count());
   for (unsigned long i=0; i < vect.count(); i++)
     writePropertyList(vect[i]);
 }
@@ -131,9 +194,9 @@ void MWAWPropertyHandlerEncoder::writePropertyListVector(const librevenge::RVNGP
 bool MWAWPropertyHandlerEncoder::getData(librevenge::RVNGBinaryData &data)
 {
   data.clear();
-  std::string d=m_f.str();
-  if (d.length() == 0) return false;
-  data.append((const unsigned char *)d.c_str(), d.length());
+  // only the header
+  if (m_data.size() <= 2) return false;
+  data.append(&m_data[0], (unsigned long) m_data.size());
   return true;
 }
 
@@ -145,36 +208,44 @@ class MWAWPropertyHandlerDecoder
 {
 public:
   //! constructor given a MWAWPropertyHandler
-  MWAWPropertyHandlerDecoder(MWAWPropertyHandler *hdl=0L):m_handler(hdl) {}
+  MWAWPropertyHandlerDecoder(MWAWPropertyHandler *hdl=0L) : m_handler(hdl), m_data(0), m_size(0), m_pos(0), m_version(1), m_nameList(), m_nameIdList(), m_delayed(false), m_eventList() {}
 
-  //! tries to read the data
-  bool readData(librevenge::RVNGBinaryData const &encoded)
+  /** tries to read the data. If delayed is set, the data are decoded
+      in a list of events which is sent to the handler only if all the data are valid */
+  bool readData(librevenge::RVNGBinaryData const &encoded, bool delayed=false)
   {
+    m_delayed=delayed;
+    m_eventList.clear();
+    m_data=encoded.getDataBuffer();
+    m_size=encoded.size();
+    m_pos=0;
+    m_version=1;
+    m_nameList.clear();
+    m_nameIdList.clear();
+    if (!m_data) return false;
+    if (m_size && m_data[0]=='V') {
+      ++m_pos;
+      unsigned long vers;
+      if (!readULong(vers) || vers!=2) {
+        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder: unknown version\n"));
+        return false;
+      }
+      m_version=2;
+    }
     try {
-      librevenge::RVNGInputStream *inp = const_cast<librevenge::RVNGInputStream *>(encoded.getDataStream());
-      if (!inp) return false;
-
-      while (!inp->isEnd()) {
-        unsigned const char *c;
-        unsigned long numRead;
-
-        c = inp->read(1,numRead);
-        if (!c || numRead != 1) {
-          MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder: can not read data type \n"));
-          return false;
-        }
-        switch (*c) {
+      while (m_pos<m_size) {
+        switch (m_data[m_pos++]) {
         case 'E':
-          if (!readInsertElement(*inp)) return false;
+          if (!readInsertElement()) return false;
           break;
         case 'S':
-          if (!readInsertElementWithList(*inp)) return false;
+          if (!readInsertElementWithList()) return false;
           break;
         case 'T':
-          if (!readCharacters(*inp)) return false;
+          if (!readCharacters()) return false;
           break;
         default:
-          MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder: unknown type='%c' \n", *c));
+          MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder: unknown type='%c' \n", char(m_data[m_pos-1])));
           return false;
         }
       }
@@ -182,52 +253,118 @@ public:
     catch (...) {
       return false;
     }
+    if (m_delayed) sendEvents();
     return true;
   }
 
 protected:
+  //! an event: an element or a list of characters
+  struct Event {
+    //! constructor
+    Event(char type, int id, char const *str) : m_type(type), m_id(id), m_string(str), m_propList()
+    {
+    }
+    //! the event type: 'E', 'S' or 'T'
+    char m_type;
+    //! the element identifier
+    int m_id;
+    //! the element name or the characters
+    char const *m_string;
+    //! the property list
+    librevenge::RVNGPropertyList m_propList;
+  };
+
+  //! sends the list of events to the handler
+  void sendEvents()
+  {
+    if (!m_handler) return;
+    for (std::deque<Event>::const_iterator it=m_eventList.begin(); it!=m_eventList.end(); ++it) {
+      switch (it->m_type) {
+      case 'E':
+        m_handler->insertElement(it->m_id, it->m_string);
+        break;
+      case 'S':
+        m_handler->insertElement(it->m_id, it->m_string, it->m_propList);
+        break;
+      case 'T':
+        m_handler->characters(librevenge::RVNGString(it->m_string));
+        break;
+      default:
+        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::sendEvents: unknown type='%c' \n", it->m_type));
+        break;
+      }
+    }
+    m_eventList.clear();
+  }
+
+  //! reads an element name, returns its handler identifier in id
+  bool readElementName(char const *&name, int &id)
+  {
+    if (m_version==1) {
+      if (!readString(name)) return false;
+      id=(m_handler && *name) ? m_handler->getElementId(name) : -1;
+      return true;
+    }
+    size_t pos;
+    if (!readName(pos)) return false;
+    name=m_nameList[pos].c_str();
+    if (m_nameIdList[pos]==-2)
+      m_nameIdList[pos]=(m_handler && *name) ? m_handler->getElementId(name) : -1;
+    id=m_nameIdList[pos];
+    return true;
+  }
+
   //! reads an simple element
-  bool readInsertElement(librevenge::RVNGInputStream &input)
+  bool readInsertElement()
   {
-    librevenge::RVNGString s;
-    if (!readString(input, s)) return false;
+    char const *s;
+    int id;
+    if (!readElementName(s, id)) return false;
 
-    if (s.empty()) {
+    if (!*s) {
       MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readInsertElement find empty tag\n"));
       return false;
     }
-    if (m_handler) m_handler->insertElement(s.cstr());
+    if (m_delayed)
+      m_eventList.push_back(Event('E', id, s));
+    else if (m_handler)
+      m_handler->insertElement(id, s);
     return true;
   }
 
   //! reads an element with a property list
-  bool readInsertElementWithList(librevenge::RVNGInputStream &input)
+  bool readInsertElementWithList()
   {
-    librevenge::RVNGString s;
-    if (!readString(input, s)) return false;
+    char const *s;
+    int id;
+    if (!readElementName(s, id)) return false;
 
-    if (s.empty()) {
+    if (!*s) {
       MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readInsertElementWithProperty: find empty tag\n"));
       return false;
     }
-    librevenge::RVNGPropertyList lists;
-    if (!readPropertyList(input, lists)) {
-      MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readInsertElementWithProperty: can not read propertyList for tag %s\n",
-                      s.cstr()));
+    librevenge::RVNGPropertyList localList;
+    if (m_delayed) m_eventList.push_back(Event('S', id, s));
+    librevenge::RVNGPropertyList &lists=m_delayed ? m_eventList.back().m_propList : localList;
+    if (!readPropertyList(lists)) {
+      MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readInsertElementWithProperty: can not read propertyList for tag %s\n", s));
       return false;
     }
 
-    if (m_handler) m_handler->insertElement(s.cstr(), lists);
+    if (!m_delayed && m_handler) m_handler->insertElement(id, s, lists);
     return true;
   }
 
   //! reads a set of characters
-  bool readCharacters(librevenge::RVNGInputStream &input)
+  bool readCharacters()
   {
-    librevenge::RVNGString s;
-    if (!readString(input, s)) return false;
-    if (!s.size()) return true;
-    if (m_handler) m_handler->characters(s);
+    char const *s;
+    if (!readString(s)) return false;
+    if (!*s) return true;
+    if (m_delayed)
+      m_eventList.push_back(Event('T', -1, s));
+    else if (m_handler)
+      m_handler->characters(librevenge::RVNGString(s));
     return true;
   }
 
@@ -236,64 +373,52 @@ protected:
   //
 
   //! low level: reads a property vector: number of properties list followed by list of properties list
-  bool readPropertyListVector(librevenge::RVNGInputStream &input, librevenge::RVNGPropertyListVector &vect)
+  bool readPropertyListVector(librevenge::RVNGPropertyListVector &vect)
   {
-    long numElt;
-    if (!readLong(input, numElt)) return false;
+    unsigned long numElt;
+    if (!readCount(numElt)) return false;
 
-    if (numElt < 0) {
-      MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readPropertyListVector: can not read numElt=%ld\n",
-                      numElt));
-      return false;
-    }
-    for (long i = 0; i < numElt; i++) {
+    for (unsigned long i = 0; i < numElt; i++) {
       librevenge::RVNGPropertyList lists;
-      if (readPropertyList(input, lists)) {
+      if (readPropertyList(lists)) {
         vect.append(lists);
         continue;
       }
-      MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readPropertyListVector: can not read property list %ld\n", i));
+      MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readPropertyListVector: can not read property list %ld\n", long(i)));
       return false;
     }
     return true;
   }
 
   //! low level: reads a property list: number of properties followed by list of properties
-  bool readPropertyList(librevenge::RVNGInputStream &input, librevenge::RVNGPropertyList &lists)
+  bool readPropertyList(librevenge::RVNGPropertyList &lists)
   {
-    long numElt;
-    if (!readLong(input, numElt)) return false;
+    unsigned long numElt;
+    if (!readCount(numElt)) return false;
 
-    if (numElt < 0) {
-      MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readPropertyList: can not read numElt=%ld\n",
-                      numElt));
-      return false;
-    }
-    for (long i = 0; i < numElt; i++) {
-      unsigned const char *c;
-      unsigned long numRead;
-      c = input.read(1,numRead);
-      if (!c || numRead != 1) {
-        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder:readPropertyList can not read data type for child %ld\n", i));
+    for (unsigned long i = 0; i < numElt; i++) {
+      if (m_pos>=m_size) {
+        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder:readPropertyList can not read data type for child %ld\n", long(i)));
         return false;
       }
-      switch (*c) {
+      unsigned char c=m_data[m_pos++];
+      switch (c) {
       case 'p':
-        if (readProperty(input, lists)) break;
-        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readPropertyList: can not read property %ld\n", i));
+        if (readProperty(lists)) break;
+        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readPropertyList: can not read property %ld\n", long(i)));
         return false;
       case 'v': {
-        librevenge::RVNGString key;
+        char const *key;
         librevenge::RVNGPropertyListVector vect;
-        if (!readString(input, key) || key.empty() || !readPropertyListVector(input, vect)) {
-          MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readPropertyList: can not read propertyVector for child %ld\n", i));
+        if (!readKey(key) || !*key || !readPropertyListVector(vect)) {
+          MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readPropertyList: can not read propertyVector for child %ld\n", long(i)));
           return false;
         }
-        lists.insert(key.cstr(),vect);
+        lists.insert(key,vect);
         break;
       }
       default:
-        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder:readPropertyList find unknown type %c for child %ld\n", (char) *c, i));
+        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder:readPropertyList find unknown type %c for child %ld\n", (char) c, long(i)));
         return false;
       }
     }
@@ -301,52 +426,177 @@ protected:
   }
 
   //! low level: reads a property and its value, adds it to \a list
-  bool readProperty(librevenge::RVNGInputStream &input, librevenge::RVNGPropertyList &list)
+  bool readProperty(librevenge::RVNGPropertyList &list)
+  {
+    char const *key;
+    if (!readKey(key)) return false;
+    if (m_version==1) {
+      char const *val;
+      if (!readString(val)) return false;
+      list.insert(key, val);
+      librevenge::RVNGProperty const *prop=list[key];
+      if (!prop) return true;
+      librevenge::RVNGUnit unit=prop->getUnit();
+      if (unit==librevenge::RVNG_POINT)
+        list.insert(key, prop->getDouble()/72., librevenge::RVNG_INCH);
+      else if (unit==librevenge::RVNG_TWIP)
+        list.insert(key, prop->getDouble()/1440., librevenge::RVNG_INCH);
+      return true;
+    }
+    if (m_pos>=m_size) return false;
+    switch (m_data[m_pos++]) {
+    case 'd': {
+      if (m_pos>=m_size) return false;
+      int unit=int(m_data[m_pos++]);
+      double val;
+      if (!readDouble(val)) return false;
+      if (unit!=librevenge::RVNG_INCH && unit!=librevenge::RVNG_PERCENT &&
+          unit!=librevenge::RVNG_POINT && unit!=librevenge::RVNG_TWIP) {
+        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readProperty: unknown unit %d\n", unit));
+        return false;
+      }
+      // as in version 1, the point and twip values are sent in inches
+      if (unit==librevenge::RVNG_POINT)
+        list.insert(key, val/72., librevenge::RVNG_INCH);
+      else if (unit==librevenge::RVNG_TWIP)
+        list.insert(key, val/1440., librevenge::RVNG_INCH);
+      else
+        list.insert(key, val, librevenge::RVNGUnit(unit));
+      break;
+    }
+    case 'i': {
+      long val;
+      if (!readLong(val)) return false;
+      list.insert(key, int(val));
+      break;
+    }
+    case 's': {
+      char const *val;
+      if (!readString(val)) return false;
+      list.insert(key, val);
+      break;
+    }
+    default:
+      MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readProperty: unknown type %c\n", char(m_data[m_pos-1])));
+      return false;
+    }
+    return true;
+  }
+
+  //! low level: reads a property key
+  bool readKey(char const *&key)
   {
-    librevenge::RVNGString key, val;
-    if (!readString(input, key)) return false;
-    if (!readString(input, val)) return false;
-
-    list.insert(key.cstr(), val);
-    librevenge::RVNGProperty const *prop=list[key.cstr()];
-    if (!prop) return true;
-    librevenge::RVNGUnit unit=prop->getUnit();
-    if (unit==librevenge::RVNG_POINT)
-      list.insert(key.cstr(), prop->getDouble()/72., librevenge::RVNG_INCH);
-    else if (unit==librevenge::RVNG_TWIP)
-      list.insert(key.cstr(), prop->getDouble()/1440., librevenge::RVNG_INCH);
+    if (m_version==1)
+      return readString(key);
+    size_t pos;
+    if (!readName(pos)) return false;
+    key=m_nameList[pos].c_str();
     return true;
   }
 
-  //! low level: reads a string : size and string
-  bool readString(librevenge::RVNGInputStream &input, librevenge::RVNGString &s)
+  //! low level: reads a name: its position in the dictionary or its definition
+  bool readName(size_t &pos)
   {
-    long numC = 0;
-    if (!readLong(input, numC)) return false;
+    unsigned long val;
+    if (!readULong(val)) return false;
+    if (val) {
+      if (val>m_nameList.size()) {
+        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readName: can not find name %ld\n", long(val)));
+        return false;
+      }
+      pos=size_t(val-1);
+      return true;
+    }
+    char const *s;
+    if (!readString(s)) return false;
+    pos=m_nameList.size();
+    m_nameList.push_back(s);
+    m_nameIdList.push_back(-2);
+    return true;
+  }
+
+  //! low level: reads a string: size and string
+  bool readString(char const *&s)
+  {
+    static char const *emptyString="";
+    unsigned long numC = 0;
+    if (m_version==1) {
+      long val;
+      if (!readLong(val) || val<0) return false;
+      numC=(unsigned long) val;
+    }
+    else if (!readULong(numC))
+      return false;
     if (numC==0) {
-      s = librevenge::RVNGString("");
+      s = emptyString;
       return true;
     }
-    unsigned long numRead;
-    const unsigned char *dt = input.read((unsigned long)numC, numRead);
-    if (dt == 0L || numRead != (unsigned long) numC) {
+    if (numC>m_size-m_pos || m_data[m_pos+numC-1]!=0) {
       MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readString: can not read a string\n"));
       return false;
     }
-    s = librevenge::RVNGString((const char *)dt);
+    s = (char const *)(m_data+m_pos);
+    m_pos+=numC;
     return true;
   }
 
-  //! low level: reads an long value
-  static bool readLong(librevenge::RVNGInputStream &input, long &val)
+  //! low level: reads a number of elements
+  bool readCount(unsigned long &val)
   {
-    unsigned long numRead = 0;
-    const unsigned char *dt = input.read(4, numRead);
-    if (dt == 0L || numRead != 4) {
+    if (m_version==2)
+      return readULong(val);
+    long numElt;
+    if (!readLong(numElt)) return false;
+    if (numElt < 0) {
+      MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readCount: can not read numElt=%ld\n", numElt));
+      return false;
+    }
+    val=(unsigned long) numElt;
+    return true;
+  }
+
+  //! low level: reads an unsigned value stored by group of 7 bits
+  bool readULong(unsigned long &val)
+  {
+    val=0;
+    for (int depl=0; depl<32; depl+=7) {
+      if (m_pos>=m_size) {
+        MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readULong: can not read a value\n"));
+        return false;
+      }
+      unsigned char c=m_data[m_pos++];
+      val|=(unsigned long)(c&0x7F)<<depl;
+      if ((c&0x80)==0) return true;
+    }
+    MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readULong: the value is too big\n"));
+    return false;
+  }
+
+  //! low level: reads an int32 value
+  bool readLong(long &val)
+  {
+    if (m_pos+4>m_size) {
       MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readLong: can not read long\n"));
       return false;
     }
-    val = long((dt[3]<<24)|(dt[2]<<16)|(dt[1]<<8)|dt[0]);
+    unsigned char const *dt=m_data+m_pos;
+    val = long(int32_t((uint32_t(dt[3])<<24)|(uint32_t(dt[2])<<16)|(uint32_t(dt[1])<<8)|dt[0]));
+    m_pos+=4;
+    return true;
+  }
+
+  //! low level: reads a double value
+  bool readDouble(double &val)
+  {
+    if (m_pos+8>m_size) {
+      MWAW_DEBUG_MSG(("MWAWPropertyHandlerDecoder::readDouble: can not read double\n"));
+      return false;
+    }
+    uint64_t value=0;
+    for (int i=7; i>=0; --i)
+      value=(value<<8)|m_data[m_pos+size_t(i)];
+    memcpy(&val, &value, 8);
+    m_pos+=8;
     return true;
   }
 private:
@@ -354,8 +604,24 @@ private:
   MWAWPropertyHandlerDecoder &operator=(MWAWPropertyHandlerDecoder const &);
 
 protected:
-  //! the streamfile
+  //! the handler
   MWAWPropertyHandler *m_handler;
+  //! the data
+  unsigned char const *m_data;
+  //! the data size
+  unsigned long m_size;
+  //! the actual position
+  unsigned long m_pos;
+  //! the data version
+  int m_version;
+  //! the dictionary of names (a deque, so that the c_str pointers stay valid)
+  std::deque<std::string> m_nameList;
+  //! the handler identifier of each name: -2 if not computed
+  std::vector<int> m_nameIdList;
+  //! a flag to know if we must store the events
+  bool m_delayed;
+  //! the list of stored events
+  std::deque<Event> m_eventList;
 };
 
 ////////////////////////////////////////////////////
@@ -375,4 +641,26 @@ bool MWAWPropertyHandler::readData(librevenge::RVNGBinaryData const &encoded)
   return decod.readData(encoded);
 }
 
+bool MWAWPropertyHandler::checkAndReadData(librevenge::RVNGBinaryData const &encoded)
+{
+  MWAWPropertyHandlerDecoder decod(this);
+  return decod.readData(encoded, true);
+}
+
+int MWAWPropertyHandler::findElementId(const char *psName, char const *const *sortedNames, int numNames)
+{
+  if (!psName || !sortedNames) return -1;
+  int minPos=0, maxPos=numNames;
+  while (minPos<maxPos) {
+    int mid=(minPos+maxPos)/2;
+    int cmp=strcmp(psName, sortedNames[mid]);
+    if (cmp==0) return mid;
+    if (cmp<0)
+      maxPos=mid;
+    else
+      minPos=mid+1;
+  }
+  return -1;
+}
+
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
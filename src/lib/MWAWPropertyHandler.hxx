@@ -35,9 +35,9 @@
 #  define MWAW_PROPERTY_HANDLER
 
 #  include <assert.h>
-#  include <ostream>
-#  include <sstream>
+#  include <map>
 #  include <string>
+#  include <vector>
 
 //! a generic property handler
 class MWAWPropertyHandler
@@ -55,29 +55,67 @@ public:
   //! writes a list of characters
   virtual void characters(librevenge::RVNGString const &sCharacters) = 0;
 
+  /** returns an identifier corresponding to an element name or -1 if the name is unknown.
+
+      \note readData calls it only once by different element name and then calls
+      insertElement(id, ...) for each element */
+  virtual int getElementId(const char * /*psName*/) const
+  {
+    return -1;
+  }
+  //! inserts a simple element given its identifier (see getElementId)
+  virtual void insertElement(int /*id*/, const char *psName)
+  {
+    insertElement(psName);
+  }
+  //! inserts an element given its identifier (see getElementId) and a property list
+  virtual void insertElement(int /*id*/, const char *psName, const librevenge::RVNGPropertyList &xPropList)
+  {
+    insertElement(psName, xPropList);
+  }
+
   //! checks a encoded librevenge::RVNGBinaryData created by MWAWPropertyHandlerEncoder
   bool checkData(librevenge::RVNGBinaryData const &encoded);
   //! reads a encoded librevenge::RVNGBinaryData created by MWAWPropertyHandlerEncoder
   bool readData(librevenge::RVNGBinaryData const &encoded);
+  /** checks and reads a encoded librevenge::RVNGBinaryData created by MWAWPropertyHandlerEncoder.
+
+      \note the data are decoded only once and nothing is sent if the data are not valid,
+      ie. this is equivalent to checkData(encoded) && readData(encoded) */
+  bool checkAndReadData(librevenge::RVNGBinaryData const &encoded);
+
+protected:
+  //! returns the position of psName in a sorted list of names or -1
+  static int findElementId(const char *psName, char const *const *sortedNames, int numNames);
 };
 
 /*! \brief write in librevenge::RVNGBinaryData a list of tags/and properties
  *
  * In order to be read by writerperfect, we must code document consisting in
  * tag and propertyList in an intermediar format:
- *  - [string:s]: an int length(s) follow by the length(s) characters of string s
- *  - [property:p]: a string value p.getStr() ( for a basic property )
- *  - [propertyList:pList]: a int: \#pList followed by
- *      -+ 'p',pList[i].key(),pList[i] for a basic child
- *      -+ 'v',pList[i].key(),*(pList.child(pList[i].key())) for a vector child
- *  - [propertyListVector:v]: a int: \#v followed by v[0], v[1], ...
- *  - [binaryData:d]: a int32 d.size() followed by the data content
+ *  - [header]: char 'V', [int] 2
+ *  - [int]: a unsigned value stored by group of 7 bits, the 8th bit meaning that a group follows
+ *  - [string:s]: an [int] length(s)+1 follow by the characters of string s and a 0 character
+ *  - [name:n]: an [int] i, if i==0, a [string] which defines the next name of the dictionary,
+ *     if not, the name stored in the dictionary at position i-1
+ *  - [property:p]:
+ *      -+ 'i', an int32 for an integer value,
+ *      -+ 'd', a char unit, a IEEE 754 double (8 bytes) for a value with unit,
+ *      -+ 's', [string] p.getStr() for the other properties
+ *  - [propertyList:pList]: an [int]: \#pList followed by
+ *      -+ 'p', [name] pList[i].key(), [property] pList[i] for a basic child
+ *      -+ 'v', [name] pList[i].key(), *(pList.child(pList[i].key())) for a vector child
+ *  - [propertyListVector:v]: an [int]: \#v followed by v[0], v[1], ...
  *
- *  - [insertElement:name]: char 'E', [string] name
- *  - [insertElement:name proplist:prop]: char 'S', [string] name, prop
+ *  - [insertElement:name]: char 'E', [name] name
+ *  - [insertElement:name proplist:prop]: char 'S', [name] name, prop
  *  - [characters:s ]: char 'T', [string] s
  *            - if len(s)==0, we write nothing
  *            - the string is written as is (ie. we do not escaped any characters).
+ *
+ * \note the decoder also accepts the data created by the previous version of the encoder
+ *  (ie. without header, whose strings and numbers are stored in little endian int32 and whose
+ *  properties are stored as a [string] key followed by [string] p.getStr())
 */
 class MWAWPropertyHandlerEncoder
 {
@@ -95,19 +133,32 @@ public:
   bool getData(librevenge::RVNGBinaryData &data);
 
 protected:
-  //! adds a long value if f
+  //! adds a character
+  void writeChar(char c)
+  {
+    m_data.push_back((unsigned char) c);
+  }
+  //! adds an unsigned value: by group of 7 bits
+  void writeULong(unsigned long val);
+  //! adds a int32 value
   void writeLong(long val);
+  //! adds a double value
+  void writeDouble(double val);
   //! adds a string: size and string
   void writeString(const librevenge::RVNGString &name);
-  //! adds a property: a string key, a string corresponding to value
-  void writeProperty(const char *key, const librevenge::RVNGProperty &prop);
+  //! adds a name: its position in the dictionary or its definition
+  void writeName(const char *name);
+  //! adds a property: a typed value
+  void writeProperty(const librevenge::RVNGProperty &prop);
   //! adds a property list: int \#prop followed by the different properties
   void writePropertyList(const librevenge::RVNGPropertyList &prop);
   //! adds a property vector: a int: \#vect followed by vect[0], vect[1], ...
   void writePropertyListVector(const librevenge::RVNGPropertyListVector &vect);
 
-  //! the streamfile
-  std::stringstream m_f;
+  //! the data
+  std::vector<unsigned char> m_data;
+  //! the dictionary: name to position
+  std::map<std::string, unsigned long> m_nameIdMap;
 };
 
 #endif
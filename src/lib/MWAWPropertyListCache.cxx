@@ -0,0 +1,124 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2002 William Lachance (wrlach@gmail.com)
+* Copyright (C) 2002,2004 Marc Maurer (uwog@uwog.net)
+* Copyright (C) 2004-2006 Fridrich Strba (fridrich.strba@bluewin.ch)
+* Copyright (C) 2006, 2007 Andrew Ziem
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+
+#include <librevenge/librevenge.h>
+
+#include "MWAWFontConverter.hxx"
+
+#include "MWAWPropertyListCache.hxx"
+
+/** Internal: the structures of a MWAWPropertyListCache */
+namespace MWAWPropertyListCacheInternal
+{
+//! the maximum number of property lists stored by map
+static size_t const s_maxNumLists=512;
+//! the maximum number of encoded patterns
+static size_t const s_maxNumPatterns=256;
+
+//! returns the key corresponding to a pattern: its dimension, its colors and its data
+static std::string getPatternKey(MWAWGraphicStyle::Pattern const &pattern)
+{
+  std::string key;
+  key.reserve(12+pattern.m_data.size());
+  for (int i=0; i<2; ++i) {
+    int val=pattern.m_dim[i];
+    key+=char(val&0xFF);
+    key+=char((val>>8)&0xFF);
+  }
+  for (int i=0; i<2; ++i) {
+    uint32_t val=pattern.m_colors[i].value();
+    for (int b=0; b<4; ++b, val>>=8)
+      key+=char(val&0xFF);
+  }
+  if (!pattern.m_data.empty())
+    key.append(reinterpret_cast<char const *>(&pattern.m_data[0]), pattern.m_data.size());
+  return key;
+}
+}
+
+MWAWPropertyListCache::MWAWPropertyListCache() : m_fontMap(), m_patternMap()
+{
+}
+
+MWAWPropertyListCache::~MWAWPropertyListCache()
+{
+}
+
+void MWAWPropertyListCache::getFontProperties(MWAWFont const &font, shared_ptr<MWAWFontConverter> fontConverter, librevenge::RVNGPropertyList &propList)
+{
+  std::map<MWAWFont, librevenge::RVNGPropertyList, FontCompare>::const_iterator it=m_fontMap.find(font);
+  if (it!=m_fontMap.end()) {
+    propList=it->second;
+    return;
+  }
+  font.addTo(propList, fontConverter);
+  if (m_fontMap.size()>=MWAWPropertyListCacheInternal::s_maxNumLists)
+    m_fontMap.clear();
+  m_fontMap.insert(std::map<MWAWFont, librevenge::RVNGPropertyList, FontCompare>::value_type(font, propList));
+}
+
+void MWAWPropertyListCache::getParagraphProperties(MWAWParagraph const &para, bool inTable, librevenge::RVNGPropertyList &propList)
+{
+  std::map<MWAWParagraph, librevenge::RVNGPropertyList, ParagraphCompare> &map=m_paragraphMap[inTable ? 1 : 0];
+  std::map<MWAWParagraph, librevenge::RVNGPropertyList, ParagraphCompare>::const_iterator it=map.find(para);
+  if (it!=map.end()) {
+    propList=it->second;
+    return;
+  }
+  para.addTo(propList, inTable);
+  if (map.size()>=MWAWPropertyListCacheInternal::s_maxNumLists)
+    map.clear();
+  map.insert(std::map<MWAWParagraph, librevenge::RVNGPropertyList, ParagraphCompare>::value_type(para, propList));
+}
+
+bool MWAWPropertyListCache::getPatternBinary(MWAWGraphicStyle::Pattern const &pattern, librevenge::RVNGBinaryData &data, std::string &type)
+{
+  // a pattern defined by a picture (and so with no data) does not need to be encoded
+  if (pattern.empty() || pattern.m_data.empty())
+    return pattern.getBinary(data, type);
+  std::string const key=MWAWPropertyListCacheInternal::getPatternKey(pattern);
+  std::map<std::string, std::pair<librevenge::RVNGBinaryData, std::string> >::const_iterator it=m_patternMap.find(key);
+  if (it!=m_patternMap.end()) {
+    data=it->second.first;
+    type=it->second.second;
+    return true;
+  }
+  if (!pattern.getBinary(data, type))
+    return false;
+  if (m_patternMap.size()>=MWAWPropertyListCacheInternal::s_maxNumPatterns)
+    m_patternMap.clear();
+  m_patternMap[key]=std::pair<librevenge::RVNGBinaryData, std::string>(data, type);
+  return true;
+}
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
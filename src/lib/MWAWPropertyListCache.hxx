@@ -0,0 +1,97 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2002 William Lachance (wrlach@gmail.com)
+* Copyright (C) 2002,2004 Marc Maurer (uwog@uwog.net)
+* Copyright (C) 2004-2006 Fridrich Strba (fridrich.strba@bluewin.ch)
+* Copyright (C) 2006, 2007 Andrew Ziem
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+
+#ifndef MWAW_PROPERTY_LIST_CACHE
+#  define MWAW_PROPERTY_LIST_CACHE
+
+#include <map>
+#include <string>
+
+#include <librevenge/librevenge.h>
+
+#include "libmwaw_internal.hxx"
+
+#include "MWAWFont.hxx"
+#include "MWAWGraphicStyle.hxx"
+#include "MWAWParagraph.hxx"
+
+/** a small class used by the listeners to store the property lists
+    corresponding to the last fonts and paragraphs and the last encoded
+    bitmap patterns, so that a style which appears many times is only
+    converted once.
+
+    \note the font property lists depend on the font converter, so a
+    cache must only be used with one font converter
+ */
+class MWAWPropertyListCache
+{
+public:
+  //! constructor
+  MWAWPropertyListCache();
+  //! destructor
+  ~MWAWPropertyListCache();
+  //! sets propList to the font's property list (as MWAWFont::addTo on an empty list)
+  void getFontProperties(MWAWFont const &font, shared_ptr<MWAWFontConverter> fontConverter, librevenge::RVNGPropertyList &propList);
+  //! sets propList to the paragraph's property list (as MWAWParagraph::addTo on an empty list)
+  void getParagraphProperties(MWAWParagraph const &para, bool inTable, librevenge::RVNGPropertyList &propList);
+  //! sets data and type to the encoded pattern (as MWAWGraphicStyle::Pattern::getBinary)
+  bool getPatternBinary(MWAWGraphicStyle::Pattern const &pattern, librevenge::RVNGBinaryData &data, std::string &type);
+
+protected:
+  //! a comparator used to store the fonts
+  struct FontCompare {
+    //! comparaison function
+    bool operator()(MWAWFont const &f1, MWAWFont const &f2) const
+    {
+      return f1.cmp(f2) < 0;
+    }
+  };
+  //! a comparator used to store the paragraphs
+  struct ParagraphCompare {
+    //! comparaison function
+    bool operator()(MWAWParagraph const &p1, MWAWParagraph const &p2) const
+    {
+      return p1.cmp(p2) < 0;
+    }
+  };
+  //! the map font to property list
+  std::map<MWAWFont, librevenge::RVNGPropertyList, FontCompare> m_fontMap;
+  //! the map paragraph to property list: 0: outside a table, 1: in a table
+  std::map<MWAWParagraph, librevenge::RVNGPropertyList, ParagraphCompare> m_paragraphMap[2];
+  //! the map pattern key to encoded pattern and mime type
+  std::map<std::string, std::pair<librevenge::RVNGBinaryData, std::string> > m_patternMap;
+};
+
+#endif
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
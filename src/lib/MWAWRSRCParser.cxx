@@ -31,6 +31,8 @@
 * instead of those above.
 */
 
+#include <algorithm>
+
 #include <librevenge/librevenge.h>
 
 #include "MWAWInputStream.hxx"
@@ -38,8 +40,66 @@
 
 #include "MWAWRSRCParser.hxx"
 
-MWAWRSRCParser::MWAWRSRCParser(MWAWInputStreamPtr input) : m_input(input), m_entryMap(), m_parsed(false), m_asciiFile(), m_asciiName("")
+/** Internal: the structures of a MWAWRSRCParser */
+namespace MWAWRSRCParserInternal
+{
+//! returns the integer corresponding to a four characters type
+static uint32_t getTypeKey(std::string const &type)
 {
+  uint32_t key=0;
+  for (size_t c=0; c<4; ++c)
+    key=(key<<8)|uint32_t((unsigned char) type[c]);
+  return key;
+}
+
+//! Internal: an index entry: (type, id) and the position in the entry map
+struct IndexEntry {
+  //! constructor
+  IndexEntry(uint32_t key, int id, std::multimap<std::string, MWAWEntry>::const_iterator it) : m_key(key), m_id(id), m_it(it)
+  {
+  }
+  //! operator<
+  bool operator<(IndexEntry const &other) const
+  {
+    if (m_key!=other.m_key) return m_key<other.m_key;
+    return m_id<other.m_id;
+  }
+  //! the type key
+  uint32_t m_key;
+  //! the resource id
+  int m_id;
+  //! the entry position in the map
+  std::multimap<std::string, MWAWEntry>::const_iterator m_it;
+};
+
+////////////////////////////////////////
+//! Internal: the state of a MWAWRSRCParser
+struct State {
+  //! the key used to retrieve a decoded resource: its position and its length
+  typedef std::pair<long, long> Key;
+  //! constructor
+  State() : m_index(), m_strListMap(), m_clutMap(), m_versMap()
+  {
+  }
+  //! returns the key corresponding to an entry
+  static Key getKey(MWAWEntry const &entry)
+  {
+    return Key(entry.begin(), entry.length());
+  }
+  //! the entries index sorted by type and id
+  std::vector<IndexEntry> m_index;
+  //! the decoded STR# resources
+  std::map<Key, std::vector<std::string> > m_strListMap;
+  //! the decoded clut resources
+  std::map<Key, std::vector<MWAWColor> > m_clutMap;
+  //! the decoded vers resources
+  std::map<Key, MWAWRSRCParser::Version> m_versMap;
+};
+}
+
+MWAWRSRCParser::MWAWRSRCParser(MWAWInputStreamPtr input) : m_input(input), m_entryMap(), m_parsed(false), m_state(), m_asciiFile(), m_asciiName("")
+{
+  m_state.reset(new MWAWRSRCParserInternal::State);
 }
 
 MWAWRSRCParser::~MWAWRSRCParser()
@@ -75,6 +135,15 @@ MWAWEntry MWAWRSRCParser::getEntry(std::string type, int id) const
 {
   if (!m_parsed)
     const_cast<MWAWRSRCParser *>(this)->parse();
+  // the index is only created if the map is read correctly, if not look in the map
+  std::vector<MWAWRSRCParserInternal::IndexEntry> const &index=m_state->m_index;
+  if (type.length()==4 && !index.empty()) {
+    MWAWRSRCParserInternal::IndexEntry toFind(MWAWRSRCParserInternal::getTypeKey(type), id, m_entryMap.end());
+    std::vector<MWAWRSRCParserInternal::IndexEntry>::const_iterator iIt=std::lower_bound(index.begin(), index.end(), toFind);
+    if (iIt!=index.end() && !(toFind<*iIt))
+      return iIt->m_it->second;
+    return MWAWEntry();
+  }
   std::multimap<std::string, MWAWEntry>::const_iterator it = m_entryMap.lower_bound(type);
   while (it != m_entryMap.end()) {
     if (it->first != type)
@@ -138,6 +207,17 @@ bool MWAWRSRCParser::parse()
       tEntry.setLength((long)m_input->readULong(4));
     }
 
+    // create the index, the stable sort keeps the map order for duplicated resources
+    std::vector<MWAWRSRCParserInternal::IndexEntry> &index=m_state->m_index;
+    index.clear();
+    index.reserve(m_entryMap.size());
+    for (it=m_entryMap.begin(); it!=m_entryMap.end(); ++it) {
+      if (it->first.length()!=4) continue;
+      index.push_back(MWAWRSRCParserInternal::IndexEntry
+                      (MWAWRSRCParserInternal::getTypeKey(it->first), it->second.id(), it));
+    }
+    std::stable_sort(index.begin(), index.end());
+
     it = m_entryMap.lower_bound("vers");
     while (it != m_entryMap.end()) {
       if (it->first != "vers")
@@ -333,6 +413,13 @@ bool MWAWRSRCParser::parseSTRList(MWAWEntry const &entry, std::vector<std::strin
     MWAW_DEBUG_MSG(("MWAWRSRCParser::parseSTRList: the entry is bad\n"));
     return false;
   }
+  MWAWRSRCParserInternal::State::Key key=MWAWRSRCParserInternal::State::getKey(entry);
+  std::map<MWAWRSRCParserInternal::State::Key, std::vector<std::string> >::const_iterator cIt=m_state->m_strListMap.find(key);
+  if (cIt!=m_state->m_strListMap.end()) {
+    entry.setParsed(true);
+    list=cIt->second;
+    return true;
+  }
   entry.setParsed(true);
   long pos = entry.begin();
   long endPos = entry.end();
@@ -376,6 +463,7 @@ bool MWAWRSRCParser::parseSTRList(MWAWEntry const &entry, std::vector<std::strin
     ascii().addPos(pos);
     ascii().addNote(f.str().c_str());
   }
+  m_state->m_strListMap[key]=list;
   return true;
 }
 
@@ -386,6 +474,13 @@ bool MWAWRSRCParser::parseClut(MWAWEntry const &entry, std::vector<MWAWColor> &l
     MWAW_DEBUG_MSG(("MWAWRSRCParser::parseClut: the entry is bad\n"));
     return false;
   }
+  MWAWRSRCParserInternal::State::Key key=MWAWRSRCParserInternal::State::getKey(entry);
+  std::map<MWAWRSRCParserInternal::State::Key, std::vector<MWAWColor> >::const_iterator cIt=m_state->m_clutMap.find(key);
+  if (cIt!=m_state->m_clutMap.end()) {
+    entry.setParsed(true);
+    list=cIt->second;
+    return true;
+  }
   entry.setParsed(true);
   long pos = entry.begin();
   // skip seed
@@ -433,6 +528,7 @@ bool MWAWRSRCParser::parseClut(MWAWEntry const &entry, std::vector<MWAWColor> &l
     ascii().addPos(pos);
     ascii().addNote(f.str().c_str());
   }
+  m_state->m_clutMap[key]=list;
   return true;
 }
 
@@ -464,6 +560,13 @@ bool MWAWRSRCParser::parseVers(MWAWEntry const &entry, Version &vers)
     MWAW_DEBUG_MSG(("MWAWRSRCParser::parseVers: entry is invalid\n"));
     return false;
   }
+  MWAWRSRCParserInternal::State::Key key=MWAWRSRCParserInternal::State::getKey(entry);
+  std::map<MWAWRSRCParserInternal::State::Key, Version>::const_iterator cIt=m_state->m_versMap.find(key);
+  if (cIt!=m_state->m_versMap.end()) {
+    entry.setParsed(true);
+    vers=cIt->second;
+    return true;
+  }
   entry.setParsed(true);
   libmwaw::DebugStream f;
   m_input->seek(entry.begin(), librevenge::RVNG_SEEK_SET);
@@ -493,6 +596,7 @@ bool MWAWRSRCParser::parseVers(MWAWEntry const &entry, Version &vers)
   f << "Entries(RSRCvers)[" << entry.id() << "]:" << vers;
   ascii().addPos(entry.begin()-4);
   ascii().addNote(f.str().c_str());
+  m_state->m_versMap[key]=vers;
   return true;
 }
 
@@ -41,6 +41,11 @@
 #include "libmwaw_internal.hxx"
 #include "MWAWDebug.hxx"
 
+namespace MWAWRSRCParserInternal
+{
+struct State;
+}
+
 /** \brief the main class to read a Mac resource fork
  */
 class MWAWRSRCParser
@@ -120,6 +125,8 @@ protected:
   std::multimap<std::string, MWAWEntry> m_entryMap;
   //! an internal flag used to know if the parsing was done
   bool m_parsed;
+  //! the internal state: the entry index and the already decoded resources
+  shared_ptr<MWAWRSRCParserInternal::State> m_state;
   //! the debug file
   libmwaw::DebugFile m_asciiFile;
   //! the debug file name
@@ -44,218 +44,423 @@
 
 #include "MWAWSpreadsheetDecoder.hxx"
 
+//! Internal: the structures of a MWAWSpreadsheetDecoder
+namespace MWAWSpreadsheetDecoderInternal
+{
+//! the different elements (sorted by name)
+enum ElementId {
+  E_CloseChart,
+  E_CloseChartPlotArea,
+  E_CloseChartSerie,
+  E_CloseChartTextObject,
+  E_CloseComment,
+  E_CloseFooter,
+  E_CloseFootnote,
+  E_CloseFrame,
+  E_CloseGroup,
+  E_CloseHeader,
+  E_CloseLink,
+  E_CloseListElement,
+  E_CloseOrderedListLevel,
+  E_ClosePageSpan,
+  E_CloseParagraph,
+  E_CloseSection,
+  E_CloseSheet,
+  E_CloseSheetCell,
+  E_CloseSheetRow,
+  E_CloseSpan,
+  E_CloseTableCell,
+  E_CloseTableRow,
+  E_CloseTextBox,
+  E_CloseUnorderedListLevel,
+  E_DefineCharacterStyle,
+  E_DefineChartStyle,
+  E_DefineEmbeddedFont,
+  E_DefineGraphicStyle,
+  E_DefinePageStyle,
+  E_DefineParagraphStyle,
+  E_DefineSectionStyle,
+  E_DefineSheetNumberingStyle,
+  E_DrawConnector,
+  E_DrawEllipse,
+  E_DrawPath,
+  E_DrawPolygon,
+  E_DrawPolyline,
+  E_DrawRectangle,
+  E_EndDocument,
+  E_InsertBinaryObject,
+  E_InsertChartAxis,
+  E_InsertCoveredTableCell,
+  E_InsertEquation,
+  E_InsertField,
+  E_InsertLineBreak,
+  E_InsertSpace,
+  E_InsertTab,
+  E_OpenChart,
+  E_OpenChartPlotArea,
+  E_OpenChartSerie,
+  E_OpenChartTextObject,
+  E_OpenComment,
+  E_OpenFooter,
+  E_OpenFootnote,
+  E_OpenFrame,
+  E_OpenGroup,
+  E_OpenHeader,
+  E_OpenLink,
+  E_OpenListElement,
+  E_OpenOrderedListLevel,
+  E_OpenPageSpan,
+  E_OpenParagraph,
+  E_OpenSection,
+  E_OpenSheet,
+  E_OpenSheetCell,
+  E_OpenSheetRow,
+  E_OpenSpan,
+  E_OpenTableCell,
+  E_OpenTableRow,
+  E_OpenTextBox,
+  E_OpenUnorderedListLevel,
+  E_SetDocumentMetaData,
+  E_StartDocument
+};
+//! the element names (sorted by name)
+static char const *const s_elementNames[]= {
+  "CloseChart",
+  "CloseChartPlotArea",
+  "CloseChartSerie",
+  "CloseChartTextObject",
+  "CloseComment",
+  "CloseFooter",
+  "CloseFootnote",
+  "CloseFrame",
+  "CloseGroup",
+  "CloseHeader",
+  "CloseLink",
+  "CloseListElement",
+  "CloseOrderedListLevel",
+  "ClosePageSpan",
+  "CloseParagraph",
+  "CloseSection",
+  "CloseSheet",
+  "CloseSheetCell",
+  "CloseSheetRow",
+  "CloseSpan",
+  "CloseTableCell",
+  "CloseTableRow",
+  "CloseTextBox",
+  "CloseUnorderedListLevel",
+  "DefineCharacterStyle",
+  "DefineChartStyle",
+  "DefineEmbeddedFont",
+  "DefineGraphicStyle",
+  "DefinePageStyle",
+  "DefineParagraphStyle",
+  "DefineSectionStyle",
+  "DefineSheetNumberingStyle",
+  "DrawConnector",
+  "DrawEllipse",
+  "DrawPath",
+  "DrawPolygon",
+  "DrawPolyline",
+  "DrawRectangle",
+  "EndDocument",
+  "InsertBinaryObject",
+  "InsertChartAxis",
+  "InsertCoveredTableCell",
+  "InsertEquation",
+  "InsertField",
+  "InsertLineBreak",
+  "InsertSpace",
+  "InsertTab",
+  "OpenChart",
+  "OpenChartPlotArea",
+  "OpenChartSerie",
+  "OpenChartTextObject",
+  "OpenComment",
+  "OpenFooter",
+  "OpenFootnote",
+  "OpenFrame",
+  "OpenGroup",
+  "OpenHeader",
+  "OpenLink",
+  "OpenListElement",
+  "OpenOrderedListLevel",
+  "OpenPageSpan",
+  "OpenParagraph",
+  "OpenSection",
+  "OpenSheet",
+  "OpenSheetCell",
+  "OpenSheetRow",
+  "OpenSpan",
+  "OpenTableCell",
+  "OpenTableRow",
+  "OpenTextBox",
+  "OpenUnorderedListLevel",
+  "SetDocumentMetaData",
+  "StartDocument"
+};
+}
+
+int MWAWSpreadsheetDecoder::getElementId(const char *psName) const
+{
+  return findElementId(psName, MWAWSpreadsheetDecoderInternal::s_elementNames, int(sizeof(MWAWSpreadsheetDecoderInternal::s_elementNames)/sizeof(char const *)));
+}
+
 void MWAWSpreadsheetDecoder::insertElement(const char *psName)
 {
-  if (!m_output) return;
   if (!psName || !*psName) {
     MWAW_DEBUG_MSG(("MWAWSpreadsheetDecoder::insertElement: called without any name\n"));
     return;
   }
+  insertElement(getElementId(psName), psName);
+}
 
-  bool ok=true;
-  switch (psName[0]) {
-  case 'C':
-    if (strcmp(psName,"CloseChart")==0)
-      m_output->closeChart();
-    else if (strcmp(psName,"CloseChartPlotArea")==0)
-      m_output->closeChartPlotArea();
-    else if (strcmp(psName,"CloseChartSerie")==0)
-      m_output->closeChartSerie();
-    else if (strcmp(psName,"CloseChartTextObject")==0)
-      m_output->closeChartTextObject();
-    else if (strcmp(psName,"CloseComment")==0)
-      m_output->closeComment();
-    else if (strcmp(psName,"CloseFooter")==0)
-      m_output->closeFooter();
-    else if (strcmp(psName,"CloseFootnote")==0)
-      m_output->closeFootnote();
-    else if (strcmp(psName,"CloseFrame")==0)
-      m_output->closeFrame();
-    else if (strcmp(psName,"CloseGroup")==0)
-      m_output->closeGroup();
-    else if (strcmp(psName,"CloseHeader")==0)
-      m_output->closeHeader();
-    else if (strcmp(psName,"CloseLink")==0)
-      m_output->closeLink();
-    else if (strcmp(psName,"CloseListElement")==0)
-      m_output->closeListElement();
-    else if (strcmp(psName,"CloseOrderedListLevel")==0)
-      m_output->closeOrderedListLevel();
-    else if (strcmp(psName,"ClosePageSpan")==0)
-      m_output->closePageSpan();
-    else if (strcmp(psName,"CloseParagraph")==0)
-      m_output->closeParagraph();
-    else if (strcmp(psName,"CloseSection")==0)
-      m_output->closeSection();
-    else if (strcmp(psName,"CloseSheet")==0)
-      m_output->closeSheet();
-    else if (strcmp(psName,"CloseSheetCell")==0)
-      m_output->closeSheetCell();
-    else if (strcmp(psName,"CloseSheetRow")==0)
-      m_output->closeSheetRow();
-    else if (strcmp(psName,"CloseSpan")==0)
-      m_output->closeSpan();
-    else if (strcmp(psName,"CloseTableCell")==0)
-      m_output->closeTableCell();
-    else if (strcmp(psName,"CloseTableRow")==0)
-      m_output->closeTableRow();
-    else if (strcmp(psName,"CloseTextBox")==0)
-      m_output->closeTextBox();
-    else if (strcmp(psName,"CloseUnorderedListLevel")==0)
-      m_output->closeUnorderedListLevel();
-    else
-      ok=false;
-    break;
-  case 'E':
-    if (strcmp(psName,"EndDocument")==0)
-      m_output->endDocument();
-    else
-      ok=false;
-    break;
-  case 'I':
-    if (strcmp(psName,"InsertTab")==0)
-      m_output->insertTab();
-    else if (strcmp(psName,"InsertSpace")==0)
-      m_output->insertSpace();
-    else if (strcmp(psName,"InsertLineBreak")==0)
-      m_output->insertLineBreak();
-    else
-      ok=false;
+void MWAWSpreadsheetDecoder::insertElement(int id, const char *psName)
+{
+  if (!m_output) return;
+  switch (id) {
+  case MWAWSpreadsheetDecoderInternal::E_CloseChart:
+    m_output->closeChart();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseChartPlotArea:
+    m_output->closeChartPlotArea();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseChartSerie:
+    m_output->closeChartSerie();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseChartTextObject:
+    m_output->closeChartTextObject();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseComment:
+    m_output->closeComment();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseFooter:
+    m_output->closeFooter();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseFootnote:
+    m_output->closeFootnote();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseFrame:
+    m_output->closeFrame();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseGroup:
+    m_output->closeGroup();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseHeader:
+    m_output->closeHeader();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseLink:
+    m_output->closeLink();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseListElement:
+    m_output->closeListElement();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseOrderedListLevel:
+    m_output->closeOrderedListLevel();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_ClosePageSpan:
+    m_output->closePageSpan();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseParagraph:
+    m_output->closeParagraph();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseSection:
+    m_output->closeSection();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseSheet:
+    m_output->closeSheet();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseSheetCell:
+    m_output->closeSheetCell();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseSheetRow:
+    m_output->closeSheetRow();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseSpan:
+    m_output->closeSpan();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseTableCell:
+    m_output->closeTableCell();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseTableRow:
+    m_output->closeTableRow();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseTextBox:
+    m_output->closeTextBox();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_CloseUnorderedListLevel:
+    m_output->closeUnorderedListLevel();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_EndDocument:
+    m_output->endDocument();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_InsertTab:
+    m_output->insertTab();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_InsertSpace:
+    m_output->insertSpace();
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_InsertLineBreak:
+    m_output->insertLineBreak();
     break;
   default:
-    ok=false;
+    MWAW_DEBUG_MSG(("MWAWSpreadsheetDecoder::insertElement: called with unexpected name %s\n", psName ? psName : "null"));
     break;
   }
-  if (!ok) {
-    MWAW_DEBUG_MSG(("MWAWSpreadsheetDecoder::insertElement: called with unexpected name %s\n", psName));
-  }
 }
 
 void MWAWSpreadsheetDecoder::insertElement(const char *psName, const librevenge::RVNGPropertyList &propList)
 {
-  if (!m_output) return;
   if (!psName || !*psName) {
     MWAW_DEBUG_MSG(("MWAWSpreadsheetDecoder::insertElement: called without any name\n"));
     return;
   }
+  insertElement(getElementId(psName), psName, propList);
+}
 
-  bool ok=true;
-  switch (psName[0]) {
-  case 'D':
-    if (strcmp(psName,"DefineCharacterStyle")==0)
-      m_output->defineCharacterStyle(propList);
-    else if (strcmp(psName,"DefineChartStyle")==0)
-      m_output->defineChartStyle(propList);
-    else if (strcmp(psName,"DefineEmbeddedFont")==0)
-      m_output->defineEmbeddedFont(propList);
-    else if (strcmp(psName,"DefineGraphicStyle")==0)
-      m_output->defineGraphicStyle(propList);
-    else if (strcmp(psName,"DefinePageStyle")==0)
-      m_output->definePageStyle(propList);
-    else if (strcmp(psName,"DefineParagraphStyle")==0)
-      m_output->defineParagraphStyle(propList);
-    else if (strcmp(psName,"DefineSectionStyle")==0)
-      m_output->defineSectionStyle(propList);
-    else if (strcmp(psName,"DefineSheetNumberingStyle")==0)
-      m_output->defineSheetNumberingStyle(propList);
-
-    else if (strcmp(psName,"DrawConnector")==0)
-      m_output->drawConnector(propList);
-    else if (strcmp(psName,"DrawEllipse")==0)
-      m_output->drawEllipse(propList);
-    else if (strcmp(psName,"DrawPath")==0)
-      m_output->drawPath(propList);
-    else if (strcmp(psName,"DrawPolygon")==0)
-      m_output->drawPolygon(propList);
-    else if (strcmp(psName,"DrawPolyline")==0)
-      m_output->drawPolyline(propList);
-    else if (strcmp(psName,"DrawRectangle")==0)
-      m_output->drawRectangle(propList);
-    else
-      ok=false;
-    break;
-  case 'I':
-    if (strcmp(psName,"InsertBinaryObject")==0)
-      m_output->insertBinaryObject(propList);
-    else if (strcmp(psName,"InsertChartAxis")==0)
-      m_output->insertChartAxis(propList);
-    else if (strcmp(psName,"InsertCoveredTableCell")==0)
-      m_output->insertCoveredTableCell(propList);
-    else if (strcmp(psName,"InsertEquation")==0)
-      m_output->insertEquation(propList);
-    else if (strcmp(psName,"InsertField")==0)
-      m_output->insertField(propList);
-    else
-      ok=false;
-    break;
-  case 'O':
-    if (strcmp(psName,"OpenChart")==0)
-      m_output->openChart(propList);
-    else if (strcmp(psName,"OpenChartPlotArea")==0)
-      m_output->openChartPlotArea(propList);
-    else if (strcmp(psName,"OpenChartSerie")==0)
-      m_output->openChartSerie(propList);
-    else if (strcmp(psName,"OpenChartTextObject")==0)
-      m_output->openChartTextObject(propList);
-    else if (strcmp(psName,"OpenComment")==0)
-      m_output->openComment(propList);
-    else if (strcmp(psName,"OpenFooter")==0)
-      m_output->openFooter(propList);
-    else if (strcmp(psName,"OpenFootnote")==0)
-      m_output->openFootnote(propList);
-    else if (strcmp(psName,"OpenFrame")==0)
-      m_output->openFrame(propList);
-    else if (strcmp(psName,"OpenGroup")==0)
-      m_output->openGroup(propList);
-    else if (strcmp(psName,"OpenHeader")==0)
-      m_output->openHeader(propList);
-    else if (strcmp(psName,"OpenLink")==0)
-      m_output->openLink(propList);
-    else if (strcmp(psName,"OpenListElement")==0)
-      m_output->openListElement(propList);
-    else if (strcmp(psName,"OpenOrderedListLevel")==0)
-      m_output->openOrderedListLevel(propList);
-    else if (strcmp(psName,"OpenPageSpan")==0)
-      m_output->openPageSpan(propList);
-    else if (strcmp(psName,"OpenParagraph")==0)
-      m_output->openParagraph(propList);
-    else if (strcmp(psName,"OpenSheet")==0)
-      m_output->openSheet(propList);
-    else if (strcmp(psName,"OpenSection")==0)
-      m_output->openSection(propList);
-    else if (strcmp(psName,"OpenSheetCell")==0)
-      m_output->openSheetCell(propList);
-    else if (strcmp(psName,"OpenSheetRow")==0)
-      m_output->openSheetRow(propList);
-    else if (strcmp(psName,"OpenSpan")==0)
-      m_output->openSpan(propList);
-    else if (strcmp(psName,"OpenTableCell")==0)
-      m_output->openTableCell(propList);
-    else if (strcmp(psName,"OpenTableRow")==0)
-      m_output->openTableRow(propList);
-    else if (strcmp(psName,"OpenTextBox")==0)
-      m_output->openTextBox(propList);
-    else if (strcmp(psName,"OpenUnorderedListLevel")==0)
-      m_output->openUnorderedListLevel(propList);
-    else
-      ok=false;
-    break;
-  case 'S':
-    if (strcmp(psName,"SetDocumentMetaData")==0)
-      m_output->setDocumentMetaData(propList);
-    else if (strcmp(psName,"StartDocument")==0)
-      m_output->startDocument(propList);
-
-    else
-      ok=false;
+void MWAWSpreadsheetDecoder::insertElement(int id, const char *psName, const librevenge::RVNGPropertyList &propList)
+{
+  if (!m_output) return;
+  switch (id) {
+  case MWAWSpreadsheetDecoderInternal::E_DefineCharacterStyle:
+    m_output->defineCharacterStyle(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DefineChartStyle:
+    m_output->defineChartStyle(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DefineEmbeddedFont:
+    m_output->defineEmbeddedFont(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DefineGraphicStyle:
+    m_output->defineGraphicStyle(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DefinePageStyle:
+    m_output->definePageStyle(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DefineParagraphStyle:
+    m_output->defineParagraphStyle(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DefineSectionStyle:
+    m_output->defineSectionStyle(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DefineSheetNumberingStyle:
+    m_output->defineSheetNumberingStyle(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DrawConnector:
+    m_output->drawConnector(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DrawEllipse:
+    m_output->drawEllipse(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DrawPath:
+    m_output->drawPath(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DrawPolygon:
+    m_output->drawPolygon(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DrawPolyline:
+    m_output->drawPolyline(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_DrawRectangle:
+    m_output->drawRectangle(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_InsertBinaryObject:
+    m_output->insertBinaryObject(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_InsertChartAxis:
+    m_output->insertChartAxis(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_InsertCoveredTableCell:
+    m_output->insertCoveredTableCell(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_InsertEquation:
+    m_output->insertEquation(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_InsertField:
+    m_output->insertField(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenChart:
+    m_output->openChart(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenChartPlotArea:
+    m_output->openChartPlotArea(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenChartSerie:
+    m_output->openChartSerie(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenChartTextObject:
+    m_output->openChartTextObject(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenComment:
+    m_output->openComment(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenFooter:
+    m_output->openFooter(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenFootnote:
+    m_output->openFootnote(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenFrame:
+    m_output->openFrame(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenGroup:
+    m_output->openGroup(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenHeader:
+    m_output->openHeader(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenLink:
+    m_output->openLink(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenListElement:
+    m_output->openListElement(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenOrderedListLevel:
+    m_output->openOrderedListLevel(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenPageSpan:
+    m_output->openPageSpan(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenParagraph:
+    m_output->openParagraph(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenSheet:
+    m_output->openSheet(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenSection:
+    m_output->openSection(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenSheetCell:
+    m_output->openSheetCell(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenSheetRow:
+    m_output->openSheetRow(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenSpan:
+    m_output->openSpan(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenTableCell:
+    m_output->openTableCell(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenTableRow:
+    m_output->openTableRow(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenTextBox:
+    m_output->openTextBox(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_OpenUnorderedListLevel:
+    m_output->openUnorderedListLevel(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_SetDocumentMetaData:
+    m_output->setDocumentMetaData(propList);
+    break;
+  case MWAWSpreadsheetDecoderInternal::E_StartDocument:
+    m_output->startDocument(propList);
     break;
   default:
-    ok=false;
+    MWAW_DEBUG_MSG(("MWAWSpreadsheetDecoder::insertElement: called with unexpected name %s\n", psName ? psName : "null"));
     break;
   }
-  if (!ok) {
-    MWAW_DEBUG_MSG(("MWAWSpreadsheetDecoder::insertElement: called with unexpected name %s\n", psName));
-  }
 }
 
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -53,10 +53,16 @@ public:
   /** destructor */
   ~MWAWSpreadsheetDecoder() {};
 
+  /** returns the identifier corresponding to an element name or -1 */
+  int getElementId(const char *psName) const;
   /** insert an element */
   void insertElement(const char *psName);
+  /** insert an element given its identifier */
+  void insertElement(int id, const char *psName);
   /** insert an element ( with a librevenge::RVNGPropertyList ) */
   void insertElement(const char *psName, const librevenge::RVNGPropertyList &xPropList);
+  /** insert an element given its identifier ( with a librevenge::RVNGPropertyList ) */
+  void insertElement(int id, const char *psName, const librevenge::RVNGPropertyList &xPropList);
   /** insert an element ( with a librevenge::RVNGPropertyListVector parameter ) */
   void insertElement(const char *psName, const librevenge::RVNGPropertyList &xPropList,
                      const librevenge::RVNGPropertyListVector &vector);
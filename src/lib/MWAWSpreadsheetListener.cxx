@@ -61,6 +61,7 @@
 #include "MWAWParagraph.hxx"
 #include "MWAWParser.hxx"
 #include "MWAWPosition.hxx"
+#include "MWAWPropertyListCache.hxx"
 #include "MWAWSection.hxx"
 #include "MWAWSubDocument.hxx"
 #include "MWAWTable.hxx"
@@ -79,7 +80,7 @@ struct DocumentState {
     m_pageList(pageList), m_pageSpan(), m_metaData(), m_footNoteNumber(0), m_smallPictureNumber(0),
     m_isDocumentStarted(false), m_isSheetOpened(false), m_isSheetRowOpened(false),
     m_sentListMarkers(), m_numberingIdMap(),
-    m_subDocuments()
+    m_subDocuments(), m_propertyListCache()
   {
   }
   //! destructor
@@ -105,6 +106,8 @@ struct DocumentState {
   /** a map cell's format to id */
   std::map<MWAWCell::Format,int,MWAWCell::CompareFormat> m_numberingIdMap;
   std::vector<MWAWSubDocumentPtr> m_subDocuments; /** list of document actually open */
+  //! the cache of font and paragraph property lists
+  MWAWPropertyListCache m_propertyListCache;
 
 private:
   DocumentState(const DocumentState &);
@@ -307,6 +310,21 @@ int MWAWSpreadsheetListener::insertCharacter(unsigned char c, MWAWInputStreamPtr
   return int(pos-debPos);
 }
 
+size_t MWAWSpreadsheetListener::insertCharacters(unsigned char const *str, size_t len)
+{
+  if (!m_ps->canWriteText()) {
+    MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::insertCharacters: called outside a text zone\n"));
+    return len;
+  }
+  if (!str || !len || !m_parserState.m_fontConverter) {
+    MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::insertCharacters: called without characters or font converter\n"));
+    return len;
+  }
+  _flushDeferredTabs();
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  return m_parserState.m_fontConverter->unicode(m_ps->m_font.id(), str, len, m_ps->m_textBuffer);
+}
+
 void MWAWSpreadsheetListener::insertUnicode(uint32_t val)
 {
   if (!m_ps->canWriteText()) {
@@ -716,7 +734,7 @@ void MWAWSpreadsheetListener::_openParagraph()
   }
 
   librevenge::RVNGPropertyList propList;
-  m_ps->m_paragraph.addTo(propList, false);
+  m_ds->m_propertyListCache.getParagraphProperties(m_ps->m_paragraph, false, propList);
   if (!m_ps->m_isParagraphOpened)
     m_documentInterface->openParagraph(propList);
 
@@ -764,7 +782,7 @@ void MWAWSpreadsheetListener::_openListElement()
     return;
 
   librevenge::RVNGPropertyList propList;
-  m_ps->m_paragraph.addTo(propList, false);
+  m_ds->m_propertyListCache.getParagraphProperties(m_ps->m_paragraph, false, propList);
   // check if we must change the start value
   int startValue=m_ps->m_paragraph.m_listStartValue.get();
   if (startValue > 0 && m_ps->m_list && m_ps->m_list->getStartValueForNextElement() != startValue) {
@@ -875,7 +893,7 @@ void MWAWSpreadsheetListener::_openSpan()
   }
 
   librevenge::RVNGPropertyList propList;
-  m_ps->m_font.addTo(propList, m_parserState.m_fontConverter);
+  m_ds->m_propertyListCache.getFontProperties(m_ps->m_font, m_parserState.m_fontConverter, propList);
 
   m_documentInterface->openSpan(propList);
 
@@ -1100,7 +1118,7 @@ void MWAWSpreadsheetListener::insertPicture
   shapePList.remove("svg:y");
 
   librevenge::RVNGPropertyList list;
-  style.addTo(list, shape.getType()==MWAWGraphicShape::Line);
+  style.addTo(list, shape.getType()==MWAWGraphicShape::Line, &m_ds->m_propertyListCache);
 
   Vec2f decal = factor*pos.origin();
   switch (shape.addTo(decal, style.hasSurface(), shapePList)) {
@@ -1778,7 +1796,7 @@ void MWAWSpreadsheetListener::insertChart
 
   shared_ptr<MWAWSpreadsheetListener> listen(this, MWAW_shared_ptr_noop_deleter<MWAWSpreadsheetListener>());
   try {
-    chart.sendChart(listen, m_documentInterface);
+    chart.sendChart(listen, m_documentInterface, &m_ds->m_propertyListCache);
   }
   catch (...) {
     MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::insertChart exception catched \n"));
@@ -150,6 +150,12 @@ public:
       \return the number of extra character read
    */
   int insertCharacter(unsigned char c, MWAWInputStreamPtr &input, long endPos=-1);
+  /** insert a run of characters using the font converter to find the
+      utf8 characters (the control characters are skipped)
+
+      \return the number of characters used
+   */
+  size_t insertCharacters(unsigned char const *str, size_t len);
   /** adds an unicode character.
    *  By convention if \a character=0xfffd(undef), no character is added */
   void insertUnicode(uint32_t character);
@@ -0,0 +1,118 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "MWAWStreamView.hxx"
+
+MWAWStreamView::MWAWStreamView(shared_ptr<librevenge::RVNGInputStream> input, long begin, long length) :
+  librevenge::RVNGInputStream(),
+  m_input(input), m_begin(begin), m_size(length), m_offset(0)
+{
+  if (!m_input || m_begin<0 || m_size<0)
+    m_size=0;
+}
+
+MWAWStreamView::~MWAWStreamView()
+{
+}
+
+const unsigned char *MWAWStreamView::read(unsigned long numBytes, unsigned long &numBytesRead)
+{
+  numBytesRead = 0;
+
+  if (numBytes == 0 || !m_input || m_offset >= m_size)
+    return 0;
+
+  unsigned long numBytesToRead=numBytes;
+  if ((unsigned long)(m_size-m_offset) < numBytesToRead)
+    numBytesToRead=(unsigned long)(m_size-m_offset);
+  if (m_input->seek(m_begin+m_offset, librevenge::RVNG_SEEK_SET) != 0)
+    return 0;
+  const unsigned char *res=m_input->read(numBytesToRead, numBytesRead);
+  if (numBytesRead > numBytesToRead) // must not happen
+    numBytesRead=numBytesToRead;
+  m_offset += (long) numBytesRead;
+  return res;
+}
+
+long MWAWStreamView::tell()
+{
+  return m_offset;
+}
+
+int MWAWStreamView::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
+{
+  if (seekType == librevenge::RVNG_SEEK_CUR)
+    m_offset += offset;
+  else if (seekType == librevenge::RVNG_SEEK_SET)
+    m_offset = offset;
+  else if (seekType == librevenge::RVNG_SEEK_END)
+    m_offset = offset+m_size;
+
+  if (m_offset < 0) {
+    m_offset = 0;
+    return -1;
+  }
+  if (m_offset > m_size) {
+    m_offset = m_size;
+    return -1;
+  }
+
+  return 0;
+}
+
+bool MWAWStreamView::isEnd()
+{
+  return m_offset >= m_size;
+}
+
+bool MWAWStreamView::isStructured()
+{
+  return false;
+}
+
+unsigned MWAWStreamView::subStreamCount()
+{
+  return 0;
+}
+
+const char *MWAWStreamView::subStreamName(unsigned)
+{
+  return 0;
+}
+
+bool MWAWStreamView::existsSubStream(const char *)
+{
+  return false;
+}
+
+librevenge::RVNGInputStream *MWAWStreamView::getSubStreamById(unsigned)
+{
+  return 0;
+}
+
+librevenge::RVNGInputStream *MWAWStreamView::getSubStreamByName(const char *)
+{
+  return 0;
+}
+
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -37,10 +37,10 @@
  *
  */
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <map>
-#include <set>
 #include <sstream>
 
 #include <librevenge/librevenge.h>
@@ -99,6 +99,20 @@ struct Compare {
   //! the coord to compare
   int m_coord;
 };
+
+/** returns the index of the position corresponding to val in the sorted list
+    of positions: the last position i>=begin such that pos[i]<val, or i+1 if
+    val is nearer to pos[i+1] */
+static size_t findClosestPosition(std::vector<float> const &pos, float val, size_t begin)
+{
+  size_t numPos=pos.size();
+  size_t i=size_t(std::lower_bound(pos.begin(), pos.end(), val)-pos.begin());
+  i=i>0 ? i-1 : 0;
+  if (i<begin) i=begin;
+  if (i+1 < numPos && (pos[i]+pos[i+1])/2 < val)
+    i++;
+  return i;
+}
 }
 
 ////////////////////////////////////////////////////////////
@@ -221,20 +235,19 @@ bool MWAWTable::buildStructures()
   size_t nCells = m_cellsList.size();
   std::vector<float> listPositions[2];
   for (int dim = 0; dim < 2; dim++) {
-    MWAWTableInternal::Compare compareFunction(dim);
-    std::set<MWAWTableInternal::Compare::Point,
-        MWAWTableInternal::Compare> set(compareFunction);
+    std::vector<MWAWTableInternal::Compare::Point> points;
+    points.reserve(2*nCells);
     for (size_t c = 0; c < nCells; ++c) {
-      set.insert(MWAWTableInternal::Compare::Point(0, m_cellsList[c].get(), int(c)));
-      set.insert(MWAWTableInternal::Compare::Point(1, m_cellsList[c].get(), int(c)));
+      points.push_back(MWAWTableInternal::Compare::Point(0, m_cellsList[c].get(), int(c)));
+      points.push_back(MWAWTableInternal::Compare::Point(1, m_cellsList[c].get(), int(c)));
     }
+    std::sort(points.begin(), points.end(), MWAWTableInternal::Compare(dim));
 
     std::vector<float> positions;
-    std::set<MWAWTableInternal::Compare::Point,
-        MWAWTableInternal::Compare>::iterator it = set.begin();
+    std::vector<MWAWTableInternal::Compare::Point>::const_iterator it = points.begin();
     float maxPosiblePos=0;
     int actCell = -1;
-    for (; it != set.end(); ++it) {
+    for (; it != points.end(); ++it) {
       float pos = it->getPos(dim);
       if (actCell < 0 || pos > maxPosiblePos) {
         actCell++;
@@ -254,20 +267,13 @@ bool MWAWTable::buildStructures()
                     };
       std::vector<float> &pos = listPositions[dim];
       size_t numPos = pos.size();
-      size_t i = 0;
-      while (i+1 < numPos && pos[i+1] < pt[0])
-        i++;
-      if (i+1 < numPos && (pos[i]+pos[i+1])/2 < pt[0])
-        i++;
+      size_t i = MWAWTableInternal::findClosestPosition(pos, pt[0], 0);
       if (i+1 > numPos) {
         MWAW_DEBUG_MSG(("MWAWTable::buildStructures: impossible to find cell position !!!\n"));
         return false;
       }
       cellPos[dim] = int(i);
-      while (i+1 < numPos && pos[i+1] < pt[1])
-        i++;
-      if (i+1 < numPos && (pos[i]+pos[i+1])/2 < pt[1])
-        i++;
+      i = MWAWTableInternal::findClosestPosition(pos, pt[1], i);
       spanCell[dim] = int(i)-cellPos[dim];
       if (spanCell[dim]==0 &&
           (m_cellsList[c]->bdBox().size()[dim] < 0 || m_cellsList[c]->bdBox().size()[dim] > 0)) {
@@ -60,6 +60,7 @@
 #include "MWAWParagraph.hxx"
 #include "MWAWParser.hxx"
 #include "MWAWPosition.hxx"
+#include "MWAWPropertyListCache.hxx"
 #include "MWAWSection.hxx"
 #include "MWAWSubDocument.hxx"
 #include "MWAWTable.hxx"
@@ -76,7 +77,7 @@ struct DocumentState {
   //! constructor
   DocumentState(std::vector<MWAWPageSpan> const &pageList) :
     m_pageList(pageList), m_pageSpan(), m_metaData(), m_footNoteNumber(0), m_endNoteNumber(0), m_smallPictureNumber(0),
-    m_isDocumentStarted(false), m_isHeaderFooterStarted(false), m_sentListMarkers(), m_subDocuments()
+    m_isDocumentStarted(false), m_isHeaderFooterStarted(false), m_sentListMarkers(), m_subDocuments(), m_propertyListCache()
   {
   }
   //! destructor
@@ -98,6 +99,8 @@ struct DocumentState {
   /// the list of marker corresponding to sent list
   std::vector<int> m_sentListMarkers;
   std::vector<MWAWSubDocumentPtr> m_subDocuments; /** list of document actually open */
+  //! the cache of font and paragraph property lists
+  MWAWPropertyListCache m_propertyListCache;
 
 private:
   DocumentState(const DocumentState &);
@@ -267,6 +270,17 @@ int MWAWTextListener::insertCharacter(unsigned char c, MWAWInputStreamPtr &input
   return int(pos-debPos);
 }
 
+size_t MWAWTextListener::insertCharacters(unsigned char const *str, size_t len)
+{
+  if (!str || !len || !m_parserState.m_fontConverter) {
+    MWAW_DEBUG_MSG(("MWAWTextListener::insertCharacters: called without characters or font converter\n"));
+    return len;
+  }
+  _flushDeferredTabs();
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  return m_parserState.m_fontConverter->unicode(m_ps->m_font.id(), str, len, m_ps->m_textBuffer);
+}
+
 void MWAWTextListener::insertUnicode(uint32_t val)
 {
   // undef character, we skip it
@@ -820,7 +834,7 @@ void MWAWTextListener::_resetParagraphState(const bool isListElement)
 
 void MWAWTextListener::_appendParagraphProperties(librevenge::RVNGPropertyList &propList, const bool /*isListElement*/)
 {
-  m_ps->m_paragraph.addTo(propList,m_ps->m_isTableOpened);
+  m_ds->m_propertyListCache.getParagraphProperties(m_ps->m_paragraph, m_ps->m_isTableOpened, propList);
 
   if (!m_ps->m_inSubDocument && m_ps->m_firstParagraphInPageSpan && m_ds->m_pageSpan.getPageNumber() >= 0)
     propList.insert("style:page-number", m_ds->m_pageSpan.getPageNumber());
@@ -967,7 +981,7 @@ void MWAWTextListener::_openSpan()
   }
 
   librevenge::RVNGPropertyList propList;
-  m_ps->m_font.addTo(propList, m_parserState.m_fontConverter);
+  m_ds->m_propertyListCache.getFontProperties(m_ps->m_font, m_parserState.m_fontConverter, propList);
 
   m_documentInterface->openSpan(propList);
 
@@ -1179,7 +1193,7 @@ void MWAWTextListener::insertPicture
   shapePList.remove("svg:y");
 
   librevenge::RVNGPropertyList list;
-  style.addTo(list, shape.getType()==MWAWGraphicShape::Line);
+  style.addTo(list, shape.getType()==MWAWGraphicShape::Line, &m_ds->m_propertyListCache);
 
   Vec2f decal = factor*pos.origin();
   switch (shape.addTo(decal, style.hasSurface(), shapePList)) {
@@ -876,11 +876,23 @@ int MacDrawParser::readObject()
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
+bool MacDrawParser::probeHeader(MWAWInputStreamPtr &input, bool /*strict*/)
+{
+  if (!input || !input->checkPosition(512))
+    return false;
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  int val=(int) input->readULong(2);
+  if (val==0x4d44) // MD: v0
+    return true;
+  // DRWGMD: v1
+  return val==0x4452 && input->readULong(2)==0x5747 && input->readULong(2)==0x4d44;
+}
+
 bool MacDrawParser::checkHeader(MWAWHeader *header, bool strict)
 {
   *m_state = MacDrawParserInternal::State();
   MWAWInputStreamPtr input = getInput();
-  if (!input || !input->hasDataFork() || !input->checkPosition(512))
+  if (!input || !input->hasDataFork() || !probeHeader(input, strict))
     return false;
 
   libmwaw::DebugStream f;
@@ -889,17 +901,12 @@ bool MacDrawParser::checkHeader(MWAWHeader *header, bool strict)
   int val=(int) input->readULong(2);
   int vers=0;
   if (val==0x4452) {
-    if (input->readULong(2)!=0x5747) return false;
-    val=(int) input->readULong(2);
-    if (val==0x4d44) vers=1;
-    else {
-      MWAW_DEBUG_MSG(("MacDrawParser::checkHeader: find unexpected header\n"));
-      return false;
-    }
+    input->seek(6, librevenge::RVNG_SEEK_SET);
+    vers=1;
     f << "version=" << vers << ",";
     f << "subVersion=" << input->readLong(2) << ",";
   }
-  else if (val==0x4d44) {
+  else {
     vers=0;
     val=(int) input->readLong(2); // find 4 for v0.9
     if (val!=4) f << "f0=" << val << ",";
@@ -908,8 +915,6 @@ bool MacDrawParser::checkHeader(MWAWHeader *header, bool strict)
       if (val) f << "f" << i+1 << "=" << val << ",";
     }
   }
-  else
-    return false;
   ascii().addPos(0);
   ascii().addNote(f.str().c_str());
 
@@ -1176,7 +1181,7 @@ bool MacDrawParser::sendBitmap(MacDrawParserInternal::Shape const &shape, MWAWPo
 #ifdef DEBUG_WITH_FILES
   static int volatile pictName = 0;
   libmwaw::DebugStream f;
-  f << "PICT-" << ++pictName << ".bmp";
+  f << "PICT-" << ++pictName << ".png";
   libmwaw::Debug::dumpFile(binary, f.str().c_str());
 #endif
 
@@ -3000,7 +3000,7 @@ bool MacDrawProParser::sendBitmap(MacDrawProParserInternal::Shape const &shape,
 #ifdef DEBUG_WITH_FILES
   static int volatile pictName = 0;
   libmwaw::DebugStream f;
-  f << "PICT-" << ++pictName << ".bmp";
+  f << "PICT-" << ++pictName << ".png";
   libmwaw::Debug::dumpFile(binary, f.str().c_str());
 #endif
 
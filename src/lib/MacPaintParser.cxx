@@ -196,6 +196,14 @@ bool MacPaintParser::readBitmap(bool onlyCheck)
   MWAWInputStreamPtr input = getInput();
   long endPos=input->size();
   input->seek(512, librevenge::RVNG_SEEK_SET);
+  if (endPos<=512) return false;
+
+  unsigned long numRead;
+  unsigned char const *data=input->read(size_t(endPos-512), numRead);
+  if (!data || long(numRead)!=endPos-512) {
+    MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read the bitmap data\n"));
+    return false;
+  }
 
   libmwaw::DebugStream f;
   // a bitmap is composed of 720 rows of (72x8bytes)
@@ -208,67 +216,28 @@ bool MacPaintParser::readBitmap(bool onlyCheck)
     pict->setColors(colors);
   }
 
+  libmwaw::PackBitsDecoder decoder;
+  unsigned char rowData[72];
+  unsigned long pos=0;
   for (int r=0; r<720; ++r) {
-    long rowPos=input->tell();
+    long rowPos=512+long(pos);
     f.str("");
     f << "Entries(Bitmap)-" << r << ":";
-    int col=0;
-    while (col<72*8) {
-      if (input->tell()+2>endPos) {
-        MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read row %d\n", r));
-        f << "###";
-        ascii().addPos(rowPos);
-        ascii().addNote(f.str().c_str());
-        return false;
-      }
-      int wh=(int) input->readULong(1);
-      if (wh>=0x81) {
-        int color=(int) input->readULong(1);
-        if (onlyCheck) {
-          col+=8*(0x101-wh);
-          continue;
-        }
-        for (int j=0; j < 0x101-wh; ++j) {
-          if (col>=72*8) {
-            MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read row %d\n", r));
-            f << "###";
-            ascii().addPos(rowPos);
-            ascii().addNote(f.str().c_str());
-            return false;
-          }
-          for (int b=7; b>=0; --b)
-            pict->set(col++, r, (color>>b)&1);
-        }
-      }
-      else {
-        if (input->tell()+wh+1>endPos) {
-          MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read row %d\n", r));
-          f << "###";
-          ascii().addPos(rowPos);
-          ascii().addNote(f.str().c_str());
-          return false;
-        }
-        for (int j=0; j < wh+1; ++j) {
-          int color=(int) input->readULong(1);
-          if (col>=72*8) {
-            MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read row %d\n", r));
-            f << "###";
-            ascii().addPos(rowPos);
-            ascii().addNote(f.str().c_str());
-            return false;
-          }
-          if (onlyCheck) {
-            col+=8;
-            continue;
-          }
-          for (int b=7; b>=0; --b)
-            pict->set(col++, r, (color>>b)&1);
-        }
-      }
+    if (!decoder.decode(data+pos, numRead-pos, onlyCheck ? 0 : rowData, 72)) {
+      MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read row %d\n", r));
+      f << "###";
+      ascii().addPos(rowPos);
+      ascii().addNote(f.str().c_str());
+      input->seek(rowPos, librevenge::RVNG_SEEK_SET);
+      return false;
     }
+    pos+=decoder.getNumRead();
+    if (!onlyCheck)
+      pict->setRowPacked(r, rowData);
     ascii().addPos(rowPos);
     ascii().addNote(f.str().c_str());
   }
+  input->seek(512+long(pos), librevenge::RVNG_SEEK_SET);
   if (!onlyCheck)
     m_state->m_bitmap=pict;
   return true;
@@ -277,11 +246,17 @@ bool MacPaintParser::readBitmap(bool onlyCheck)
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
+bool MacPaintParser::probeHeader(MWAWInputStreamPtr &input, bool /*strict*/)
+{
+  // a 512 bytes header followed by at least 720 packed lines
+  return input && input->checkPosition(512+720*2);
+}
+
 bool MacPaintParser::checkHeader(MWAWHeader *header, bool strict)
 {
   *m_state = MacPaintParserInternal::State();
   MWAWInputStreamPtr input = getInput();
-  if (!input || !input->hasDataFork() || !input->checkPosition(512+720*2))
+  if (!input || !input->hasDataFork() || !probeHeader(input, strict))
     return false;
 
   int const vers=1;
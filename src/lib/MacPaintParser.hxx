@@ -62,6 +62,8 @@ public:
 
   //! checks if the document header is correct (or not)
   bool checkHeader(MWAWHeader *header, bool strict=false);
+  //! checks quickly the beginning of the file without creating a parser (called by checkHeader)
+  static bool probeHeader(MWAWInputStreamPtr &input, bool strict=false);
 
   // the main parse function
   void parse(librevenge::RVNGDrawingInterface *documentInterface);
@@ -686,7 +686,28 @@ bool MacWrtParser::sendWindow(int zone)
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
-bool MacWrtParser::checkHeader(MWAWHeader *header, bool /*strict*/)
+bool MacWrtParser::probeHeader(MWAWInputStreamPtr &input, bool /*strict*/)
+{
+  if (!input || !input->checkPosition(40))
+    return false;
+  input->seek(0,librevenge::RVNG_SEEK_SET);
+  // 3: v1.0-2.2, 6: version 4.5 ( also version 5.01 of Claris MacWrite )
+  int vers = (int) input->readULong(2);
+  if (vers!=3 && vers!=6)
+    return false;
+  long dataPos=vers==3 ? (long) input->readULong(2) : 0;
+  for (int i = 0; i < 3; i++) {
+    if (input->readLong(2) < 0) // the number of paragraphs
+      return false;
+  }
+  if (vers==6) {
+    input->seek(18,librevenge::RVNG_SEEK_SET);
+    dataPos=(long) input->readULong(4); // the free list position
+  }
+  return input->checkPosition(dataPos);
+}
+
+bool MacWrtParser::checkHeader(MWAWHeader *header, bool strict)
 {
   *m_state = MacWrtParserInternal::State();
   MacWrtParserInternal::FileHeader fHeader = m_state->m_fileHeader;
@@ -697,48 +718,22 @@ bool MacWrtParser::checkHeader(MWAWHeader *header, bool /*strict*/)
 
   libmwaw::DebugStream f;
   int headerSize=40;
-  if (!input->checkPosition(headerSize)) {
-    MWAW_DEBUG_MSG(("MacWrtParser::checkHeader: file is too short\n"));
+  if (!probeHeader(input, strict)) {
+    MWAW_DEBUG_MSG(("MacWrtParser::checkHeader: the file header seems bad\n"));
     return false;
   }
   input->seek(0,librevenge::RVNG_SEEK_SET);
 
   int vers = (int) input->readULong(2);
   setVersion(vers);
-
-  std::string vName("");
-
-  switch (vers) {
-  case 3:
-    vName="v1.0-2.2";
-    break;
-  case 6: // version 4.5 ( also version 5.01 of Claris MacWrite )
-    vName="v4.5-5.01";
-    break;
-  default:
-    MWAW_DEBUG_MSG(("MacWrtParser::checkHeader: unknown version\n"));
-    return false;
-  }
-  if (!vName.length()) {
-    MWAW_DEBUG_MSG(("Maybe a MacWrite file unknown version(%d)\n", vers));
-  }
-  else {
-    MWAW_DEBUG_MSG(("MacWrite file %s\n", vName.c_str()));
-  }
+  MWAW_DEBUG_MSG(("MacWrite file %s\n", vers==3 ? "v1.0-2.2" : "v4.5-5.01"));
 
   f << "FileHeader: vers=" << vers << ",";
 
   if (vers <= 3) fHeader.m_dataPos = (int) input->readULong(2);
 
-  for (int i = 0; i < 3; i++) {
-    int numParag = (int) input->readLong(2);
-    fHeader.m_numParagraphs[i] = numParag;
-    if (numParag < 0) {
-      MWAW_DEBUG_MSG(("MacWrtParser::checkHeader: numParagraphs is negative : %d\n",
-                      numParag));
-      return false;
-    }
-  }
+  for (int i = 0; i < 3; i++)
+    fHeader.m_numParagraphs[i] = (int) input->readLong(2);
 
   if (vers <= 3) {
     input->seek(6, librevenge::RVNG_SEEK_CUR); // unknown
@@ -769,9 +764,6 @@ bool MacWrtParser::checkHeader(MWAWHeader *header, bool /*strict*/)
     for (int i=0; i<3; ++i)
       if (!readWindowsInfo(i) && i==2) return false;
   }
-  if (!input->checkPosition(vers <= 3 ? fHeader.m_dataPos : fHeader.m_freeListPos))
-    return false;
-
   input->seek(headerSize, librevenge::RVNG_SEEK_SET);
   m_state->m_fileHeader = fHeader;
 
@@ -1361,8 +1353,21 @@ bool MacWrtParser::readText(MacWrtParserInternal::Information const &info,
         getTextListener()->insertTab();
       else if (c == 0xd)
         getTextListener()->insertEOL();
-      else
+      else if (c < 0x20)
         getTextListener()->insertCharacter(c);
+      else {
+        // send the following basic characters (until the next format) in one call
+        int runEnd = actFormat < numFormat ? listPos[(size_t)actFormat] : numChar;
+        if (runEnd <= i || runEnd > numChar) runEnd = numChar;
+        int len = 1;
+        while (i+len < runEnd && (unsigned char) text[size_t(i+len)] >= 0x20)
+          ++len;
+        unsigned char const *run = reinterpret_cast<unsigned char const *>(text.c_str())+i;
+        int used = int(getTextListener()->insertCharacters(run, size_t(len)));
+        if (used < len)
+          getTextListener()->insertCharacter(run[used]);
+        i += len-1;
+      }
     }
   }
 
@@ -654,58 +654,65 @@ bool MacWrtProParser::createZones()
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
-bool MacWrtProParser::checkHeader(MWAWHeader *header, bool strict)
+bool MacWrtProParser::probeHeader(MWAWInputStreamPtr &input, bool strict)
 {
-  *m_state = MacWrtProParserInternal::State();
-
-  MWAWInputStreamPtr input = getInput();
-  if (!input || !input->hasDataFork())
+  if (!input || !input->checkPosition(4+0x78))
     return false;
-
-  libmwaw::DebugStream f;
-  int const headerSize=4;
-  if (!input->checkPosition(headerSize+0x78)) {
-    MWAW_DEBUG_MSG(("MacWrtProParser::checkHeader: file is too short\n"));
-    return false;
-  }
   input->seek(0,librevenge::RVNG_SEEK_SET);
 
   int vers = (int) input->readULong(2);
   int val = (int) input->readULong(2);
-
-  f << "FileHeader:";
   switch (vers) {
   case 0x2e:
-    vers = 0;
-    if (val != 0x2e)
-      return false;
-    break;
+    return val == 0x2e;
   case 4:
-    vers = 1;
     if (val != 4) {
 #ifdef DEBUG
       if (strict || val < 3 || val > 5)
         return false;
-      f << "#unk=" << val << ",";
 #else
       return false;
 #endif
     }
     break;
   default:
-    MWAW_DEBUG_MSG(("MacWrtProParser::checkHeader: unknown version\n"));
     return false;
   }
+  if (strict) {
+    input->seek(0xdd, librevenge::RVNG_SEEK_SET);
+    // "MP" seems always in this position
+    if (input->readULong(2) != 0x4d50)
+      return false;
+  }
+  return true;
+}
+
+bool MacWrtProParser::checkHeader(MWAWHeader *header, bool strict)
+{
+  *m_state = MacWrtProParserInternal::State();
+
+  MWAWInputStreamPtr input = getInput();
+  if (!input || !input->hasDataFork())
+    return false;
+
+  libmwaw::DebugStream f;
+  int const headerSize=4;
+  if (!probeHeader(input, strict)) {
+    MWAW_DEBUG_MSG(("MacWrtProParser::checkHeader: the file header seems bad\n"));
+    return false;
+  }
+  input->seek(0,librevenge::RVNG_SEEK_SET);
+
+  int vers = input->readULong(2)==0x2e ? 0 : 1;
+  int val = (int) input->readULong(2);
+
+  f << "FileHeader:";
+  if (vers==1 && val != 4)
+    f << "#unk=" << val << ",";
   setVersion(vers);
   f << "vers=" << vers << ",";
-  if (strict) {
-    if (vers) {
-      input->seek(0xdd, librevenge::RVNG_SEEK_SET);
-      // "MP" seems always in this position
-      if (input->readULong(2) != 0x4d50)
-        return false;
-    }
-    else if (!readPrintInfo()) { // last chance, check DocHeader
+  if (strict && !vers) {
+    if (!readPrintInfo()) { // last chance, check DocHeader
       input->seek(4+0x78, librevenge::RVNG_SEEK_SET);
       if (input->readULong(2)) return false;
       val=(int) input->readULong(2);
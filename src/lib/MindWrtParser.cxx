@@ -1379,6 +1379,29 @@ bool MindWrtParser::readFonts(MWAWEntry const &entry, std::vector<MWAWFont> &fon
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
+bool MindWrtParser::probeHeader(MWAWInputStreamPtr &input, bool strict)
+{
+  int const headerSize=0x50;
+  if (!input || !input->checkPosition(headerSize))
+    return false;
+  input->seek(0,librevenge::RVNG_SEEK_SET);
+  if (input->readULong(2) != 0x7704)
+    return false;
+  if (!strict)
+    return true;
+  long numLines[3];
+  for (int i = 0; i < 3; i++)
+    numLines[i] = (long) input->readULong(2);
+  // check the line info block size
+  input->seek(headerSize, librevenge::RVNG_SEEK_SET);
+  for (int i = 0; i < 3; i++) {
+    input->seek(4, librevenge::RVNG_SEEK_CUR);
+    if (input->readLong(4) != 32*numLines[i])
+      return false;
+  }
+  return true;
+}
+
 bool MindWrtParser::checkHeader(MWAWHeader *header, bool strict)
 {
   *m_state = MindWrtParserInternal::State();
@@ -1388,14 +1411,9 @@ bool MindWrtParser::checkHeader(MWAWHeader *header, bool strict)
     return false;
   libmwaw::DebugStream f;
 
-  int const headerSize=0x50;
-  if (!input->checkPosition(headerSize)) {
-    MWAW_DEBUG_MSG(("MindWrtParser::checkHeader: file is too short\n"));
-    return false;
-  }
-  input->seek(0,librevenge::RVNG_SEEK_SET);
-  if (input->readULong(2) != 0x7704)
+  if (!probeHeader(input, strict))
     return false;
+  input->seek(2,librevenge::RVNG_SEEK_SET);
   if (header)
     header->reset(MWAWDocument::MWAW_T_MINDWRITE, 2);
 
@@ -1463,25 +1481,12 @@ bool MindWrtParser::checkHeader(MWAWHeader *header, bool strict)
     if (val) f << "j" << i << "=" << val << ",";
   }
 
-  bool ok = true;
-  if (strict) {
-    // check the line info block size
-    input->seek(0x50, librevenge::RVNG_SEEK_SET);
-    for (int i = 0; i < 3; i++) {
-      input->seek(4, librevenge::RVNG_SEEK_CUR);
-      if (input->readLong(4) == 32*m_state->m_numLinesByZone[i])
-        continue;
-      ok = false;
-      break;
-    }
-    input->seek(0x50, librevenge::RVNG_SEEK_SET);
-  }
   ascii().addPos(pos);
   ascii().addNote(f.str().c_str());
   ascii().addPos(input->tell());
   ascii().addNote("_");
 
-  return ok;
+  return true;
 }
 
 ////////////////////////////////////////////////////////////
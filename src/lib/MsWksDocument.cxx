@@ -994,11 +994,25 @@ bool MsWksDocument::readZone(MsWksDocument::Zone &zone)
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
+bool MsWksDocument::probeHeader(MWAWInputStreamPtr &input, bool strict)
+{
+  if (!input) return false;
+  if (input->isStructured()) // a v4 file, checked by MsWks4Zone
+    return true;
+  if (!input->checkPosition(0x20+1))
+    return false;
+  input->seek(0,librevenge::RVNG_SEEK_SET);
+  long vers = (long) input->readULong(4);
+  if (vers==4 || vers==8 || vers==9 || vers==11)
+    return true;
+  return !strict && vers <= 14;
+}
+
 bool MsWksDocument::checkHeader3(MWAWHeader *header, bool strict)
 {
   *m_state = MsWksDocumentInternal::State();
   MWAWInputStreamPtr input = getInput();
-  if (!input || !input->hasDataFork())
+  if (!input || !input->hasDataFork() || !probeHeader(input, strict))
     return false;
 
   int numError = 0, val;
@@ -1025,18 +1039,9 @@ bool MsWksDocument::checkHeader3(MWAWHeader *header, bool strict)
     setVersion(1);
     break;
   default:
-    if (strict) return false;
-
     MWAW_DEBUG_MSG(("MsWksDocument::checkHeader3: find unknown version 0x%x\n", (unsigned int) vers));
-    // must we stop in this case, or can we continue ?
-    if (vers < 0 || vers > 14) {
-      MWAW_DEBUG_MSG(("MsWksDocument::checkHeader3: version too big, we stop\n"));
-      return false;
-    }
     setVersion((vers < 4) ? 1 : (vers < 8) ? 2 : (vers < 11) ? 3 : 4);
   }
-  if (input->seek(headerSize,librevenge::RVNG_SEEK_SET) != 0 || input->isEnd())
-    return false;
 
   if (input->seek(12,librevenge::RVNG_SEEK_SET) != 0) return false;
 
@@ -134,6 +134,10 @@ public:
 
   //! checks if the file header corresponds to a v1-v3 document (or not)
   bool checkHeader3(MWAWHeader *header, bool strict=false);
+  /** checks quickly the beginning of the file without creating a parser (called by checkHeader3)
+
+      \note always returns true for a structured v4 file */
+  static bool probeHeader(MWAWInputStreamPtr &input, bool strict=false);
   //! returns the length of the file header of a v1-v3 document (if know)
   long getLengthOfFileHeader3() const;
   //! read the print info zone (v1-v3)
@@ -122,6 +122,7 @@ struct Zone {
   Zone(MWAWInputStreamPtr input, libmwaw::DebugFile &asc):
     m_type(Unknown), m_subType(0), m_defPosition(0), m_entry(), m_hiLoEndian(true),
     m_entriesList(), m_name(""), m_extra(""), m_input(input), m_defaultInput(true),
+    m_needUnpack(false),
     m_asciiName(""), m_asciiFile(&asc), m_localAsciiFile()
   {
     for (int i=0; i<3; ++i) m_ids[i]=m_idsFlag[i]=0;
@@ -140,9 +141,11 @@ struct Zone {
 
   //! operator<<
   friend std::ostream &operator<<(std::ostream &o, Zone const &z);
-  //! returns the current input
+  //! returns the current input (unpacks first the zone data if needed)
   MWAWInputStreamPtr getInput()
   {
+    if (m_needUnpack)
+      unpack();
     return m_input;
   }
   //! reset the current input
@@ -156,6 +159,13 @@ struct Zone {
   {
     return m_defaultInput;
   }
+  //! marks the zone as packed: its data will be unpacked when its input is asked
+  void setPacked()
+  {
+    m_needUnpack=true;
+  }
+  //! try to unpack the zone data
+  bool unpack();
   //! returns the current ascii file
   libmwaw::DebugFile &ascii()
   {
@@ -210,6 +220,8 @@ protected:
   MWAWInputStreamPtr m_input;
   //! a flag used to know if the input is or not the default input
   bool m_defaultInput;
+  //! a flag used to know if the zone data must be unpacked
+  bool m_needUnpack;
   //! the ascii file name ( used if we need to create a ascii file)
   std::string m_asciiName;
   //! the ascii file corresponding to an input
@@ -283,6 +295,221 @@ std::ostream &operator<<(std::ostream &o, Zone const &z)
   return o;
 }
 
+////////////////////////////////////////
+//! Internal: the LZW decoder used to unpack the zones of a RagTime5Parser
+class LZWDecoder
+{
+public:
+  //! constructor
+  LZWDecoder() : m_prefixList(), m_suffixList(), m_firstList(), m_lengthList(), m_numRead(0), m_numWritten(0)
+  {
+  }
+  /** decompresses src in dst until the end code is found.
+
+      \return false if the data are bad or if the decompressed data do not fit in dst
+   */
+  bool decode(unsigned char const *src, unsigned long srcSize, unsigned char *dst, unsigned long dstSize);
+  //! returns the number of bytes read by the last decode call
+  unsigned long getNumRead() const
+  {
+    return m_numRead;
+  }
+  //! returns the number of bytes written by the last decode call
+  unsigned long getNumWritten() const
+  {
+    return m_numWritten;
+  }
+protected:
+  //! adds a new code in the table
+  void addCode(unsigned int prefix, unsigned char suffix, unsigned char first, unsigned long length)
+  {
+    m_prefixList.push_back(prefix);
+    m_suffixList.push_back(suffix);
+    m_firstList.push_back(first);
+    m_lengthList.push_back(length);
+  }
+  //! the prefix code list
+  std::vector<unsigned int> m_prefixList;
+  //! the last character of each code
+  std::vector<unsigned char> m_suffixList;
+  //! the first character of each code
+  std::vector<unsigned char> m_firstList;
+  //! the length of each code
+  std::vector<unsigned long> m_lengthList;
+  //! the number of read bytes
+  unsigned long m_numRead;
+  //! the number of written bytes
+  unsigned long m_numWritten;
+};
+
+bool LZWDecoder::decode(unsigned char const *src, unsigned long srcSize, unsigned char *dst, unsigned long dstSize)
+{
+  m_numRead=m_numWritten=0;
+  m_prefixList.resize(0);
+  m_suffixList.resize(0);
+  m_firstList.resize(0);
+  m_lengthList.resize(0);
+  if (!src || (dstSize && !dst)) return false;
+  m_prefixList.reserve(4096);
+  m_suffixList.reserve(4096);
+  m_firstList.reserve(4096);
+  m_lengthList.reserve(4096);
+
+  int szField=9, nBits=0;
+  unsigned int bits=0;
+  while (true) {
+    size_t numCodes=m_lengthList.size();
+    if (numCodes==(size_t(1)<<szField)-0x102) {
+      if (++szField>24) {
+        MWAW_DEBUG_MSG(("RagTime5ParserInternal::LZWDecoder::decode: the code size is too big\n"));
+        return false;
+      }
+    }
+    do {
+      if (m_numRead>=srcSize) {
+        MWAW_DEBUG_MSG(("RagTime5ParserInternal::LZWDecoder::decode: oops can not find last data\n"));
+        return false;
+      }
+      bits=(bits<<8)|src[m_numRead++];
+      nBits+=8;
+    }
+    while (nBits<szField);
+    unsigned int val=bits>>(nBits-szField);
+    nBits-=szField;
+    bits&=(1u<<nBits)-1;
+
+    if (val<0x100) {
+      if (m_numWritten>=dstSize) return false;
+      unsigned char c=(unsigned char) val;
+      dst[m_numWritten++]=c;
+      addCode(0, c, c, 1);
+      continue;
+    }
+    if (val==0x100) { // begin
+      if (m_numWritten) {
+        // data are reset when the number of codes is 3835, so it is ok
+        m_prefixList.resize(0);
+        m_suffixList.resize(0);
+        m_firstList.resize(0);
+        m_lengthList.resize(0);
+        szField=9;
+      }
+      continue;
+    }
+    if (val==0x101) {
+      if (bits) {
+        MWAW_DEBUG_MSG(("RagTime5ParserInternal::LZWDecoder::decode: find 0x101 in bad position\n"));
+        return false;
+      }
+      return true;
+    }
+    size_t code=size_t(val-0x102);
+    if (code>=numCodes) {
+      MWAW_DEBUG_MSG(("RagTime5ParserInternal::LZWDecoder::decode: find bad position\n"));
+      return false;
+    }
+    // a code is the string of code followed by the first character of the next code
+    unsigned long length=m_lengthList[code];
+    if (m_numWritten+length+1>dstSize) return false;
+    unsigned char last=m_firstList[code+1<numCodes ? code+1 : code];
+    unsigned char *ptr=dst+m_numWritten+length;
+    *ptr=last;
+    for (size_t c=code; ; c=size_t(m_prefixList[c])) {
+      *(--ptr)=m_suffixList[c];
+      if (m_lengthList[c]==1) break;
+    }
+    m_numWritten+=length+1;
+    addCode((unsigned int) code, last, m_firstList[code], length+1);
+  }
+  return false;
+}
+
+////////////////////////////////////////
+//! Internal: try to unpack the data of an entry
+static bool unpackData(MWAWInputStreamPtr input, MWAWEntry const &entry, std::vector<unsigned char> &data)
+{
+  if (!entry.valid() || !input)
+    return false;
+
+  long pos=entry.begin(), endPos=entry.end();
+  if (entry.length()<4 || !input->checkPosition(endPos)) {
+    MWAW_DEBUG_MSG(("RagTime5ParserInternal::unpackData: the input seems bad\n"));
+    return false;
+  }
+
+  bool actEndian=input->readInverted();
+  input->setReadInverted(false);
+  input->seek(pos, librevenge::RVNG_SEEK_SET);
+
+  data.resize(0);
+  unsigned long sz=(unsigned long) input->readULong(4);
+  if (sz==0) {
+    input->setReadInverted(actEndian);
+    return true;
+  }
+  int flag=int(sz>>24);
+  sz &= 0xFFFFFF;
+  if ((flag&0xf) || (flag&0xf0)==0 || !(sz&0xFFFFFF)) {
+    input->setReadInverted(actEndian);
+    return false;
+  }
+
+  data.resize(size_t(sz));
+  unsigned long numRead;
+  unsigned char const *packedData=input->read(size_t(endPos-pos-4), numRead);
+  LZWDecoder decoder;
+  bool ok=packedData && decoder.decode(packedData, numRead, &data[0], sz);
+  input->seek(pos+4+long(decoder.getNumRead()), librevenge::RVNG_SEEK_SET);
+  if (ok && decoder.getNumWritten()!=sz) {
+    MWAW_DEBUG_MSG(("RagTime5ParserInternal::unpackData: oops the data file is bad\n"));
+    ok=false;
+  }
+  if (!ok) {
+    MWAW_DEBUG_MSG(("RagTime5ParserInternal::unpackData: stop with totalSize=%ld/%ld\n", long(decoder.getNumWritten()), long(sz)));
+    data.resize(size_t(decoder.getNumWritten()));
+  }
+  input->setReadInverted(actEndian);
+  return ok;
+}
+
+bool Zone::unpack()
+{
+  m_needUnpack=false;
+  std::vector<unsigned char> newData;
+  long pos=m_entry.begin(), endPos=m_entry.end();
+  bool ok=unpackData(m_input, m_entry, newData);
+  if (ok && m_input->tell()!=endPos) {
+    MWAW_DEBUG_MSG(("RagTime5ParserInternal::Zone::unpack: find some extra data\n"));
+    ok=false;
+  }
+  if (!ok) {
+    MWAW_DEBUG_MSG(("RagTime5ParserInternal::Zone::unpack: can not unpack the zone %d\n", m_ids[0]));
+    libmwaw::DebugStream f;
+    f << "Entries(BADPACK)[" << *this << "]:###" << m_kinds[0];
+    ascii().addPos(pos);
+    ascii().addNote(f.str().c_str());
+    m_entry.setLength(0);
+    return false;
+  }
+  if (newData.empty()) {
+    // empty zone
+    ascii().addPos(pos);
+    ascii().addNote("_");
+    m_entry.setLength(0);
+    return true;
+  }
+
+  if (isMainInput())
+    ascii().skipZone(pos, endPos-1);
+
+  shared_ptr<MWAWStringStream> newStream(new MWAWStringStream(&newData[0], (unsigned int) newData.size()));
+  MWAWInputStreamPtr newInput(new MWAWInputStream(newStream, false));
+  setInput(newInput);
+  m_entry.setBegin(0);
+  m_entry.setLength(newInput->size());
+  return true;
+}
+
 ////////////////////////////////////////
 //! Internal: the state of a RagTime5Parser
 struct State {
@@ -600,15 +827,9 @@ bool RagTime5Parser::createZones()
     int usedId=zone.m_kinds[1].empty() ? 0 : 1;
     std::string actType=zone.getKindLastPart(usedId==0);
     if (actType=="Pack") {
-      if (!unpackZone(zone)) {
-        MWAW_DEBUG_MSG(("RagTime5Parser::createZones: can not unpack the zone %d\n", zone.m_ids[0]));
-        libmwaw::DebugFile &ascFile=zone.ascii();
-        f.str("");
-        f << "Entries(BADPACK)[" << zone << "]:###" << zone.m_kinds[usedId];
-        ascFile.addPos(zone.m_entry.begin());
-        ascFile.addNote(f.str().c_str());
-        continue;
-      }
+      // the zone will be unpacked when its data are needed
+      zone.setPacked();
+      zone.m_extra += "packed,";
       size_t length=zone.m_kinds[usedId].size();
       if (length>5)
         zone.m_kinds[usedId].resize(length-5);
@@ -754,8 +975,8 @@ bool RagTime5Parser::readCompressedLong(MWAWInputStreamPtr &input, long endPos,
 
 bool RagTime5Parser::readString(RagTime5ParserInternal::Zone &zone, std::string &text)
 {
-  if (!zone.m_entry.valid()) return false;
   MWAWInputStreamPtr input=zone.getInput();
+  if (!zone.m_entry.valid()) return false;
   libmwaw::DebugFile &ascFile=zone.ascii();
   libmwaw::DebugStream f;
   f << "Entries(StringZone)[" << zone << "]:";
@@ -784,13 +1005,13 @@ bool RagTime5Parser::readString(RagTime5ParserInternal::Zone &zone, std::string
 
 bool RagTime5Parser::readUnicodeString(RagTime5ParserInternal::Zone &zone)
 {
+  MWAWInputStreamPtr input=zone.getInput();
   long length=zone.m_entry.length();
   if (length==0) return true;
   if ((length%2)!=0) {
     MWAW_DEBUG_MSG(("RagTime5Parser::readUnicodeString: find unexpected data length\n"));
     return false;
   }
-  MWAWInputStreamPtr input=zone.getInput();
   // unicode string seems to ignore hilo/lohi flag, so...
   libmwaw::DebugFile &ascFile=zone.ascii();
   libmwaw::DebugStream f;
@@ -816,11 +1037,11 @@ bool RagTime5Parser::readUnicodeString(RagTime5ParserInternal::Zone &zone)
 
 bool RagTime5Parser::readItemCluster(RagTime5ParserInternal::Zone &zone)
 {
+  MWAWInputStreamPtr input=zone.getInput();
   MWAWEntry &entry=zone.m_entry;
   if (entry.length()==0) return true;
   if (entry.length()<13) return false;
 
-  MWAWInputStreamPtr input=zone.getInput();
   long endPos=entry.end();
   input->setReadInverted(!zone.m_hiLoEndian);
   input->seek(entry.begin(), librevenge::RVNG_SEEK_SET);
@@ -942,8 +1163,8 @@ bool RagTime5Parser::readItemCluster(RagTime5ParserInternal::Zone &zone)
 
 bool RagTime5Parser::readListZone(RagTime5ParserInternal::Zone &zone)
 {
-  if (zone.m_entry.length()<150) return false;
   MWAWInputStreamPtr input=zone.getInput();
+  if (zone.m_entry.length()<150) return false;
   input->setReadInverted(!zone.m_hiLoEndian);
   libmwaw::DebugStream f;
   f << "Entries(ListZone)[" << zone << "]:";
@@ -1071,146 +1292,6 @@ bool RagTime5Parser::update(RagTime5ParserInternal::Zone &zone)
   return true;
 }
 
-bool RagTime5Parser::unpackZone(RagTime5ParserInternal::Zone &zone, MWAWEntry const &entry, std::vector<unsigned char> &data)
-{
-  if (!entry.valid())
-    return false;
-
-  MWAWInputStreamPtr input=zone.getInput();
-  long pos=entry.begin(), endPos=entry.end();
-  if (entry.length()<4 || !input->checkPosition(endPos)) {
-    MWAW_DEBUG_MSG(("RagTime5Parser::unpackZone: the input seems bad\n"));
-    return false;
-  }
-
-  bool actEndian=input->readInverted();
-  input->setReadInverted(false);
-  input->seek(pos, librevenge::RVNG_SEEK_SET);
-
-  data.resize(0);
-  unsigned long sz=(unsigned long) input->readULong(4);
-  if (sz==0) {
-    input->setReadInverted(actEndian);
-    return true;
-  }
-  int flag=int(sz>>24);
-  sz &= 0xFFFFFF;
-  if ((flag&0xf) || (flag&0xf0)==0 || !(sz&0xFFFFFF)) {
-    input->setReadInverted(actEndian);
-    return false;
-  }
-
-  int nBytesRead=0, szField=9;
-  unsigned int read=0;
-  size_t mapPos=0;
-  data.reserve(size_t(sz));
-  std::vector<std::vector<unsigned char> > mapToString;
-  mapToString.reserve(size_t(entry.length()-6));
-  bool ok=false;
-  while (!input->isEnd()) {
-    if ((int) mapPos==(1<<szField)-0x102)
-      ++szField;
-    if (input->tell()>=endPos) {
-      MWAW_DEBUG_MSG(("RagTime5Parser::unpackZone: oops can not find last data\n"));
-      ok=false;
-      break;
-    }
-    do {
-      read = (read<<8)+(unsigned int) input->readULong(1);
-      nBytesRead+=8;
-    }
-    while (nBytesRead<szField);
-    unsigned int val=(read >> (nBytesRead-szField));
-    nBytesRead-=szField;
-    read &= ((1<<nBytesRead)-1);
-
-    if (val<0x100) {
-      unsigned char c=(unsigned char) val;
-      data.push_back(c);
-      if (mapPos>= mapToString.size())
-        mapToString.resize(mapPos+1);
-      mapToString[mapPos++]=std::vector<unsigned char>(1,c);
-      continue;
-    }
-    if (val==0x100) { // begin
-      if (!data.empty()) {
-        // data are reset when mapPos=3835, so it is ok
-        mapPos=0;
-        mapToString.resize(0);
-        szField=9;
-      }
-      continue;
-    }
-    if (val==0x101) {
-      ok=read==0;
-      if (!ok) {
-        MWAW_DEBUG_MSG(("RagTime5Parser::unpackZone: find 0x101 in bad position\n"));
-      }
-      break;
-    }
-    size_t readPos=size_t(val-0x102);
-    if (readPos >= mapToString.size()) {
-      MWAW_DEBUG_MSG(("RagTime5Parser::unpackZone: find bad position\n"));
-      ok = false;
-      break;
-    }
-    std::vector<unsigned char> final=mapToString[readPos++];
-    if (readPos==mapToString.size())
-      final.push_back(final[0]);
-    else
-      final.push_back(mapToString[readPos][0]);
-    data.insert(data.end(), final.begin(), final.end());
-    if (mapPos>= mapToString.size())
-      mapToString.resize(mapPos+1);
-    mapToString[mapPos++]=final;
-  }
-
-  if (ok && data.size()!=(size_t) sz) {
-    MWAW_DEBUG_MSG(("RagTime5Parser::unpackZone: oops the data file is bad\n"));
-    ok=false;
-  }
-  if (!ok) {
-    MWAW_DEBUG_MSG(("RagTime5Parser::unpackZone: stop with mapPos=%ld and totalSize=%ld/%ld\n", long(mapPos), long(data.size()), long(sz)));
-  }
-  input->setReadInverted(actEndian);
-  return ok;
-}
-
-bool RagTime5Parser::unpackZone(RagTime5ParserInternal::Zone &zone)
-{
-  if (!zone.m_entry.valid())
-    return false;
-
-  std::vector<unsigned char> newData;
-  if (!unpackZone(zone, zone.m_entry, newData))
-    return false;
-  long pos=zone.m_entry.begin(), endPos=zone.m_entry.end();
-  MWAWInputStreamPtr input=zone.getInput();
-  if (input->tell()!=endPos) {
-    MWAW_DEBUG_MSG(("RagTime5Parser::unpackZone: find some extra data\n"));
-    return false;
-  }
-  if (newData.empty()) {
-    // empty zone
-    zone.ascii().addPos(pos);
-    zone.ascii().addNote("_");
-    zone.m_entry.setLength(0);
-    zone.m_extra += "packed,";
-    return true;
-  }
-
-  if (input.get()==getInput().get())
-    ascii().skipZone(pos, endPos-1);
-
-  shared_ptr<MWAWStringStream> newStream(new MWAWStringStream(&newData[0], (unsigned int) newData.size()));
-  MWAWInputStreamPtr newInput(new MWAWInputStream(newStream, false));
-  zone.setInput(newInput);
-  zone.m_entry.setBegin(0);
-  zone.m_entry.setLength(newInput->size());
-  zone.m_extra += "packed,";
-  return true;
-}
-
 ////////////////////////////////////////////////////////////
 // read the different zones
 ////////////////////////////////////////////////////////////
@@ -1266,6 +1347,7 @@ bool RagTime5Parser::readDocumentVersion(RagTime5ParserInternal::Zone &zone)
 bool RagTime5Parser::readPictureList(RagTime5ParserInternal::Zone &zone, std::vector<int> &listIds)
 {
   listIds.resize(0);
+  MWAWInputStreamPtr input = zone.getInput();
   libmwaw::DebugFile &ascFile=zone.ascii();
   libmwaw::DebugStream f;
   f << "Entries(PictureList)[" << zone << "]:";
@@ -1285,7 +1367,6 @@ bool RagTime5Parser::readPictureList(RagTime5ParserInternal::Zone &zone, std::ve
     return false;
   }
 
-  MWAWInputStreamPtr input = zone.getInput();
   input->setReadInverted(!zone.m_hiLoEndian); // checkme never seens
   input->seek(entry.begin(), librevenge::RVNG_SEEK_SET);
 
@@ -1306,6 +1387,7 @@ bool RagTime5Parser::readPictureList(RagTime5ParserInternal::Zone &zone, std::ve
 
 bool RagTime5Parser::readPictureMatch(RagTime5ParserInternal::Zone &zone, bool color)
 {
+  MWAWInputStreamPtr input = zone.getInput();
   libmwaw::DebugFile &ascFile=zone.ascii();
   libmwaw::DebugStream f;
   f << "Entries(" << (color ? "PictureColMatch" : "PictureMatch") << ")[" << zone << "]:";
@@ -1326,7 +1408,6 @@ bool RagTime5Parser::readPictureMatch(RagTime5ParserInternal::Zone &zone, bool c
     return false;
   }
 
-  MWAWInputStreamPtr input = zone.getInput();
   input->setReadInverted(!zone.m_hiLoEndian); // checkme never seens
   input->seek(entry.begin(), librevenge::RVNG_SEEK_SET);
 
@@ -1369,9 +1450,9 @@ bool RagTime5Parser::readPictureMatch(RagTime5ParserInternal::Zone &zone, bool c
 
 bool RagTime5Parser::readPicture(RagTime5ParserInternal::Zone &zone, MWAWEntry &entry, PictureType type)
 {
+  MWAWInputStreamPtr input = zone.getInput();
   if (entry.length()<=40)
     return false;
-  MWAWInputStreamPtr input = zone.getInput();
   input->seek(entry.begin(), librevenge::RVNG_SEEK_SET);
   long val;
   std::string extension("");
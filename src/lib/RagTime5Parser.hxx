@@ -98,11 +98,6 @@ protected:
   //! try to update a zone: create a new input if the zone is stored in different positions, ...
   bool update(RagTime5ParserInternal::Zone &zone);
 
-  //! try to unpack a zone
-  bool unpackZone(RagTime5ParserInternal::Zone &zone, MWAWEntry const &entry, std::vector<unsigned char> &data);
-  //! try to unpack a zone
-  bool unpackZone(RagTime5ParserInternal::Zone &zone);
-
   //! try to read a compressed long
   bool readCompressedLong(MWAWInputStreamPtr &input, long endPos, long &val);
   //! try to read a string zone ( zone with id1=21,id2=23:24)
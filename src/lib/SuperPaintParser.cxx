@@ -911,6 +911,8 @@ bool SuperPaintParser::readBitmap(bool onlyCheck)
     pict->setColors(colors);
   }
 
+  libmwaw::PackBitsDecoder decoder;
+  std::vector<unsigned char> rowData;
   while (!input->isEnd()) {
     pos=input->tell();
     f.str("");
@@ -951,54 +953,29 @@ bool SuperPaintParser::readBitmap(bool onlyCheck)
       }
       f.str("");
       f << "Bitmap-R" << r << ":";
-      int col=dim[1];
-      while (input->tell()<rEndPos) {
-        int wh=(int) input->readULong(1);
-        if (wh>=0x81) {
-          int color=(int) input->readULong(1);
-          if (onlyCheck) {
-            col+=8*(0x101-wh);
-          }
-          else {
-            for (int j=0; j < 0x101-wh; ++j) {
-              for (int b=7; b>=0; --b) {
-                if (col<pictDim[3])
-                  pict->set(col, r, (color>>b)&1);
-                ++col;
-              }
-            }
-          }
-        }
-        else {
-          if (input->tell()+wh+1>rEndPos) {
-            MWAW_DEBUG_MSG(("SuperPaintParser::readBitmap: can not read row %d\n", r));
-            f << "###";
-            ascii().addPos(pos);
-            ascii().addNote(f.str().c_str());
-            return false;
-          }
-          if (onlyCheck) {
-            col+=8*(wh+1);
-            input->seek(wh+1, librevenge::RVNG_SEEK_CUR);
-          }
-          else {
-            for (int j=0; j < wh+1; ++j) {
-              int color=(int) input->readULong(1);
-              for (int b=7; b>=0; --b) {
-                if (col<pictDim[3])
-                  pict->set(col, r, (color>>b)&1);
-                ++col;
-              }
-            }
-          }
-        }
-        if (col>pictDim[3]+8) {
-          MWAW_DEBUG_MSG(("SuperPaintParser::readBitmap: can not read row %d\n", r));
-          f << "###";
-          ascii().addPos(pos);
-          ascii().addNote(f.str().c_str());
-          return false;
-        }
+      unsigned long numRead;
+      unsigned char const *data=input->read(size_t(len), numRead);
+      // the row can not go after pictDim[3]+8
+      long maxBytes=(pictDim[3]+8-dim[1])/8;
+      if (!data || long(numRead)!=len || maxBytes<0) {
+        MWAW_DEBUG_MSG(("SuperPaintParser::readBitmap: can not read row %d\n", r));
+        f << "###";
+        ascii().addPos(pos);
+        ascii().addNote(f.str().c_str());
+        return false;
+      }
+      rowData.resize(size_t(maxBytes)+1);
+      if (!decoder.decode(data, numRead, onlyCheck ? 0 : &rowData[0], (unsigned long) maxBytes, true)) {
+        MWAW_DEBUG_MSG(("SuperPaintParser::readBitmap: can not read row %d\n", r));
+        f << "###";
+        ascii().addPos(pos);
+        ascii().addNote(f.str().c_str());
+        return false;
+      }
+      int col=dim[1]+8*int(decoder.getNumWritten());
+      if (!onlyCheck) {
+        for (int c=dim[1], i=0; c<col && c<pictDim[3]; ++c, ++i)
+          pict->set(c, r, (rowData[size_t(i/8)]>>(7-(i%8)))&1);
       }
       f << "col=" << col << ",";
       ascii().addPos(pos);
@@ -1034,34 +1011,39 @@ bool SuperPaintParser::readBitmap(bool onlyCheck)
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
+bool SuperPaintParser::probeHeader(MWAWInputStreamPtr &input, bool /*strict*/)
+{
+  if (!input || !input->checkPosition(512))
+    return false;
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  if (input->readULong(2)!=0x1000) return false;
+  input->seek(10, librevenge::RVNG_SEEK_SET);
+  int val=(int) input->readLong(2); // 1: paint, 2: draw
+  return val==1 || val==2;
+}
+
 bool SuperPaintParser::checkHeader(MWAWHeader *header, bool strict)
 {
   *m_state = SuperPaintParserInternal::State();
   MWAWInputStreamPtr input = getInput();
-  if (!input || !input->hasDataFork() || !input->checkPosition(512))
+  if (!input || !input->hasDataFork() || !probeHeader(input, strict))
     return false;
 
   int const vers=1;
   libmwaw::DebugStream f;
   f << "FileHeader:";
-  input->seek(0, librevenge::RVNG_SEEK_SET);
-  if (input->readULong(2)!=0x1000) return false;
+  input->seek(2, librevenge::RVNG_SEEK_SET);
   int dim[4];
   for (int i=0; i<4; ++i) dim[i]=(int) input->readLong(2);
   if (dim[0]||dim[1]||dim[2]||dim[3])
     f << "bitmap[content]=" << dim[1] << "x" << dim[0] << "<->" << dim[3] << "x" << dim[2] << ",";
   int val=(int) input->readLong(2);
-  switch (val) {
-  case 1:
+  if (val==1) {
     m_state->m_kind=MWAWDocument::MWAW_K_PAINT;
     f << "paint,";
-    break;
-  case 2: // not yet implemented
-    f << "draw,";
-    break;
-  default:
-    return false;
   }
+  else // not yet implemented
+    f << "draw,";
   val=(int) input->readLong(1);
   if (val==1) f << "hasPrintInfo?,";
   else if (val) f << "#f0=" << val << ",";
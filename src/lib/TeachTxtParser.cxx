@@ -330,11 +330,44 @@ bool TeachTxtParser::sendText()
     case 0xca:
       sendPicture(1000+nPict++);
       break;
-    default:
-      if (c < 0x20) f  << "##[" << std::hex << int(c) << std::dec << "]";
-      i += getTextListener()->insertCharacter(c, input, endPos);
+    default: {
+      if (c < 0x20) {
+        f  << "##[" << std::hex << int(c) << std::dec << "]";
+        i += getTextListener()->insertCharacter(c, input, endPos);
+        break;
+      }
+      // send the following basic characters (until the next font) in one call
+      long runEnd=endPos;
+      fontIt=m_state->m_posFontMap.upper_bound(i);
+      if (fontIt != m_state->m_posFontMap.end() && fontIt->first < runEnd)
+        runEnd=fontIt->first;
+      long runPos=input->tell()-1;
+      input->seek(runPos, librevenge::RVNG_SEEK_SET);
+      unsigned long numRead;
+      unsigned char const *run=input->read((unsigned long)(runEnd-i), numRead);
+      if (!run || !numRead) {
+        input->seek(runPos+1, librevenge::RVNG_SEEK_SET);
+        i += getTextListener()->insertCharacter(c, input, endPos);
+        break;
+      }
+      size_t len=1;
+      while (len < size_t(numRead) && run[len]>=0x20 && run[len]!=0xca) {
+        f << run[len];
+        ++len;
+      }
+      size_t used=getTextListener()->insertCharacters(run, len);
+      if (used < len) {
+        // the last character needs the following one
+        c=run[used];
+        input->seek(runPos+long(used)+1, librevenge::RVNG_SEEK_SET);
+        i += long(used)+getTextListener()->insertCharacter(c, input, endPos);
+        break;
+      }
+      input->seek(runPos+long(len), librevenge::RVNG_SEEK_SET);
+      i += long(len)-1;
       break;
     }
+    }
   }
   return true;
 }
@@ -49,7 +49,6 @@
 #include "MWAWPictMac.hxx"
 #include "MWAWPrinter.hxx"
 #include "MWAWSpreadsheetListener.hxx"
-#include "MWAWStringStream.hxx"
 
 #include "WingzParser.hxx"
 
@@ -1770,8 +1769,18 @@ bool WingzParser::findNextZone(int lastType)
 {
   MWAWInputStreamPtr input = getInput();
   bool lastCheck=true;
+  std::vector<std::string> patterns(1, std::string(1, '\x80'));
   while (!input->isEnd()) {
     long pos=input->tell();
+    // skip directly to the word which contains the next 0x80
+    if (!input->findNext(patterns))
+      return false;
+    long newPos=pos+2*((input->tell()-pos)/2);
+    if (newPos!=pos) {
+      lastCheck=false;
+      pos=newPos;
+    }
+    input->seek(pos, librevenge::RVNG_SEEK_SET);
     int val=(int)input->readULong(2);
     int type=val&0xFF;
     if (type==0x80) {
@@ -2462,6 +2471,136 @@ bool WingzParser::readChartData()
 ////////////////////////////////////////////////////////////
 // decode an encrypted file
 ////////////////////////////////////////////////////////////
+namespace WingzParserInternal
+{
+/** Internal: a stream which decrypts the data of an encrypted Wingz
+    file when they are read
+
+    \note the first 12 bytes are not encrypted, the crypt flag (byte 12)
+    is reset to avoid problem, the next data are encrypted using a
+    basic xor method */
+class DecryptStream: public librevenge::RVNGInputStream
+{
+public:
+  //! constructor
+  explicit DecryptStream(MWAWInputStreamPtr input) : librevenge::RVNGInputStream(),
+    m_input(input), m_size(input ? input->size() : 0), m_offset(0), m_buffer()
+  {
+    // the key only depends on the position modulo 256
+    static uint8_t const codeString[]= { 0x53, 0x66, 0xA5, 0x35, 0x5A, 0xAA, 0x55, 0xE3 };
+    for (int i=0; i<256; ++i)
+      m_key[i]=uint8_t((codeString[(i&7)]+i)&0xFF);
+  }
+  //! reads numbytes data and decrypts them
+  const unsigned char *read(unsigned long numBytes, unsigned long &numBytesRead)
+  {
+    numBytesRead=0;
+    if (!numBytes || !m_input || m_offset>=m_size)
+      return 0;
+    if ((unsigned long)(m_size-m_offset)<numBytes)
+      numBytes=(unsigned long)(m_size-m_offset);
+    m_input->seek(m_offset, librevenge::RVNG_SEEK_SET);
+    uint8_t const *data=m_input->read(size_t(numBytes), numBytesRead);
+    if (!data || !numBytesRead) {
+      numBytesRead=0;
+      return 0;
+    }
+    if (m_buffer.size()<numBytesRead)
+      m_buffer.resize(size_t(numBytesRead));
+    unsigned long i=0;
+    long pos=m_offset;
+    for (; i<numBytesRead && pos<13; ++i, ++pos)
+      m_buffer[i]=pos==12 ? 0 : data[i];
+    // the encrypted data: first go to the next multiple of 256, then decrypt by blocks of 256 bytes
+    for (; i<numBytesRead && ((pos-13)&0xFF); ++i, ++pos)
+      m_buffer[i]=uint8_t(data[i]^m_key[(pos-13)&0xFF]);
+    for (; i+256<=numBytesRead; i+=256, pos+=256) {
+      uint8_t *dst=&m_buffer[i];
+      uint8_t const *src=data+i;
+      for (int j=0; j<256; ++j)
+        dst[j]=uint8_t(src[j]^m_key[j]);
+    }
+    for (; i<numBytesRead; ++i, ++pos)
+      m_buffer[i]=uint8_t(data[i]^m_key[(pos-13)&0xFF]);
+    m_offset+=long(numBytesRead);
+    return &m_buffer[0];
+  }
+  //! returns actual offset position
+  long tell()
+  {
+    return m_offset;
+  }
+  //! seeks to a offset position, from actual, beginning or ending position
+  int seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
+  {
+    if (seekType == librevenge::RVNG_SEEK_CUR)
+      m_offset += offset;
+    else if (seekType == librevenge::RVNG_SEEK_SET)
+      m_offset = offset;
+    else if (seekType == librevenge::RVNG_SEEK_END)
+      m_offset = offset+m_size;
+    if (m_offset < 0) {
+      m_offset = 0;
+      return -1;
+    }
+    if (m_offset > m_size) {
+      m_offset = m_size;
+      return -1;
+    }
+    return 0;
+  }
+  //! returns true if we are at the end of the file
+  bool isEnd()
+  {
+    return m_offset >= m_size;
+  }
+  //! returns false
+  bool isStructured()
+  {
+    return false;
+  }
+  //! returns 0
+  unsigned subStreamCount()
+  {
+    return 0;
+  }
+  //! returns 0
+  const char *subStreamName(unsigned)
+  {
+    return 0;
+  }
+  //! returns false
+  bool existsSubStream(const char *)
+  {
+    return false;
+  }
+  //! returns 0
+  librevenge::RVNGInputStream *getSubStreamByName(const char *)
+  {
+    return 0;
+  }
+  //! returns 0
+  librevenge::RVNGInputStream *getSubStreamById(unsigned)
+  {
+    return 0;
+  }
+protected:
+  //! the encrypted input
+  MWAWInputStreamPtr m_input;
+  //! the input size
+  long m_size;
+  //! the actual offset
+  long m_offset;
+  //! the buffer which contains the last decrypted data
+  std::vector<uint8_t> m_buffer;
+  //! the xor key
+  uint8_t m_key[256];
+private:
+  DecryptStream(DecryptStream const &orig);
+  DecryptStream &operator=(DecryptStream const &orig);
+};
+}
+
 bool WingzParser::decodeEncrypted()
 {
   MWAWInputStreamPtr input = getInput();
@@ -2470,35 +2609,8 @@ bool WingzParser::decodeEncrypted()
     MWAW_DEBUG_MSG(("WingzParser::decodeEncrypted: the file seems too short\n"));
     return false;
   }
-  input->seek(0, librevenge::RVNG_SEEK_SET);
-  unsigned long read;
-  uint8_t const *data=input->read(size_t(length), read);
-  if (!data || length!=long(read)) {
-    MWAW_DEBUG_MSG(("WingzParser::decodeEncrypted: can not read the buffer\n"));
-    return false;
-  }
-  uint8_t *buffer=new uint8_t[length];
-  if (!buffer) {
-    MWAW_DEBUG_MSG(("WingzParser::decodeEncrypted: can not allocate a buffer\n"));
-    return false;
-  }
-  // the first 12 bytes encoded
-  for (int i=0; i<12; i++) buffer[i]=data[i];
-  // reset the crypt flag to avoid problem
-  buffer[12]=0;
-  // the next data are encrypted using a basic xor method...
-  int delta=0;
-  for (long i=13; i<length; ++i) {
-    uint8_t const codeString[]= { 0x53, 0x66, 0xA5, 0x35, 0x5A, 0xAA, 0x55, 0xE3 };
-    uint8_t v=uint8_t((codeString[(delta&7)]+delta)&0xFF);
-    buffer[i]=(data[i]^v);
-    delta++;
-  }
-
-  // finally replace the actual input with a new input
-  shared_ptr<librevenge::RVNGInputStream> newInput
-  (new MWAWStringStream(buffer, (unsigned int)length));
-  delete [] buffer;
+  // replace the actual input with an input which decrypts the data when they are read
+  shared_ptr<librevenge::RVNGInputStream> newInput(new WingzParserInternal::DecryptStream(input));
   getParserState()->m_input.reset(new MWAWInputStream(newInput, false));
   return true;
 }
@@ -1022,6 +1022,36 @@ WriteNowEntry WriteNowParser::readEntry()
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
+bool WriteNowParser::probeHeader(MWAWInputStreamPtr &input, bool strict)
+{
+  int const headerSize=28;
+  if (!input || !input->checkPosition(headerSize))
+    return false;
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  long val = (long) input->readULong(4);
+  if (val==0) { // v2
+    if (input->readULong(4) != 0)
+      return false;
+    if (!strict)
+      return true;
+    for (int i=0; i < 4; ++i) {
+      val = long(input->readLong(1));
+      if (val!=4 && val!=0x44) return false;
+      input->seek(3, librevenge::RVNG_SEEK_CUR);
+    }
+    return true;
+  }
+  if (val!=0x57726974 || input->readULong(4) != 0x654e6f77) // WriteNow
+    return false;
+  val = (long) input->readULong(2);
+  if (strict && val > 3)
+    return false;
+#ifndef DEBUG
+  if (val != 2) return false;
+#endif
+  return true;
+}
+
 bool WriteNowParser::checkHeader(MWAWHeader *header, bool strict)
 {
   *m_state = WriteNowParserInternal::State();
@@ -1031,41 +1061,19 @@ bool WriteNowParser::checkHeader(MWAWHeader *header, bool strict)
     return false;
 
   libmwaw::DebugStream f;
-  int headerSize=28;
-  input->seek(headerSize,librevenge::RVNG_SEEK_SET);
-  if (int(input->tell()) != headerSize) {
-    MWAW_DEBUG_MSG(("WriteNowParser::checkHeader: file is too short\n"));
+  int const headerSize=28;
+  if (!probeHeader(input, strict)) {
+    MWAW_DEBUG_MSG(("WriteNowParser::checkHeader: the file header seems bad\n"));
     return false;
   }
   input->seek(0, librevenge::RVNG_SEEK_SET);
   long val = (long) input->readULong(4);
-  int vers = 0;
-  switch (val) {
-  case 0:
-    if (input->readULong(4) != 0)
-      return false;
-    vers = 2;
-    break;
-  case 0x57726974: // Writ
-    if (input->readULong(4) != 0x654e6f77) // eNow
-      return false;
-    vers = 3;
-    break;
-  default:
-    return false;
-  }
+  int vers = val==0 ? 2 : 3;
+  input->seek(8, librevenge::RVNG_SEEK_SET);
   setVersion(vers);
   f << "FileHeader:";
 
   if (vers < 3) {
-    if (strict) {
-      for (int i=0; i < 4; ++i) {
-        val = long(input->readLong(1));
-        if (val!=4 && val!=0x44) return false;
-        input->seek(3, librevenge::RVNG_SEEK_CUR);
-      }
-      input->seek(8, librevenge::RVNG_SEEK_SET);
-    }
 
     ascii().addPos(0);
     ascii().addNote(f.str().c_str());
@@ -1075,11 +1083,6 @@ bool WriteNowParser::checkHeader(MWAWHeader *header, bool strict)
   }
 
   val = (long) input->readULong(2);
-  if (strict && val > 3)
-    return false;
-#ifndef DEBUG
-  if (val != 2) return false;
-#endif
   f << "f0=" << val << ",";
 
   for (int i = 1; i < 4; i++) {
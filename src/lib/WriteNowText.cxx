@@ -1874,10 +1874,26 @@ bool WriteNowText::send(std::vector<WriteNowTextInternal::ContentZone> &listZone
           setProperty(ruler);
           actTabs = 0;
           break;
-        default:
-          listener->insertCharacter(c);
+        default: {
+          if (c < 0x20) {
+            listener->insertCharacter(c);
+            break;
+          }
+          // send the following basic characters in one call
+          unsigned char const *run=buffer-1;
+          long len=1;
+          while (i+len < sz && run[len] >= 0x20) {
+            f << run[len];
+            ++len;
+          }
+          long used=long(listener->insertCharacters(run, size_t(len)));
+          if (used < len)
+            listener->insertCharacter(run[used]);
+          buffer += len-1;
+          i += int(len-1);
           break;
         }
+        }
       }
       ascFile.addPos(zone.m_pos[0]);
       ascFile.addNote(f.str().c_str());
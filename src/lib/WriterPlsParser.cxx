@@ -767,22 +767,23 @@ bool WriterPlsParser::createZones()
 ////////////////////////////////////////////////////////////
 // read the header
 ////////////////////////////////////////////////////////////
+bool WriterPlsParser::probeHeader(MWAWInputStreamPtr &input, bool /*strict*/)
+{
+  int const headerSize=2;
+  if (!input || !input->checkPosition(headerSize))
+    return false;
+  input->seek(0,librevenge::RVNG_SEEK_SET);
+  return input->readULong(2) == 0x110;
+}
+
 bool WriterPlsParser::checkHeader(MWAWHeader *header, bool strict)
 {
   *m_state = WriterPlsParserInternal::State();
 
   MWAWInputStreamPtr input = getInput();
-  if (!input || !input->hasDataFork())
-    return false;
-
-  int const headerSize=2;
-  if (!input->checkPosition(headerSize)) {
-    MWAW_DEBUG_MSG(("WriterPlsParser::checkHeader: file is too short\n"));
-    return false;
-  }
-  input->seek(0,librevenge::RVNG_SEEK_SET);
-  if (input->readULong(2) != 0x110)
+  if (!input || !input->hasDataFork() || !probeHeader(input, strict))
     return false;
+  input->seek(2,librevenge::RVNG_SEEK_SET);
   ascii().addPos(0);
   ascii().addNote("FileHeader");
 
@@ -419,6 +419,33 @@ ZWrtText::TextCode ZWrtText::isTextCode
   return None;
 }
 
+size_t ZWrtText::sendCharacters(MWAWInputStreamPtr &input, long pos, long endPos, char stopChar, libmwaw::DebugStream &f)
+{
+  MWAWTextListenerPtr listener=m_parserState->m_textListener;
+  input->seek(pos, librevenge::RVNG_SEEK_SET);
+  unsigned long numRead;
+  unsigned char const *run=endPos>pos ? input->read((unsigned long)(endPos-pos), numRead) : 0;
+  if (!listener || !run || !numRead) {
+    MWAW_DEBUG_MSG(("ZWrtText::sendCharacters: can not read the characters\n"));
+    input->seek(pos+1, librevenge::RVNG_SEEK_SET);
+    return 1;
+  }
+  size_t len=1;
+  while (len < size_t(numRead) && run[len]>=0x20 && run[len]!=(unsigned char) stopChar)
+    ++len;
+  f << std::string(reinterpret_cast<char const *>(run), len);
+  size_t used=listener->insertCharacters(run, len);
+  if (used < len) {
+    // the last character needs the following character
+    unsigned char c=run[used];
+    input->seek(pos+long(used)+1, librevenge::RVNG_SEEK_SET);
+    listener->insertCharacter(c, input, endPos);
+  }
+  else
+    input->seek(pos+long(len), librevenge::RVNG_SEEK_SET);
+  return len;
+}
+
 bool ZWrtText::sendText(ZWrtTextInternal::Section const &zone, MWAWEntry const &entry)
 {
   MWAWTextListenerPtr listener=m_parserState->m_textListener;
@@ -518,9 +545,18 @@ bool ZWrtText::sendText(ZWrtTextInternal::Section const &zone, MWAWEntry const &
         listener->setParagraph(para);
       }
       break;
-    default:
-      listener->insertCharacter((unsigned char) c, input, endPos);
-      break;
+    default: {
+      if ((unsigned char) c < 0x20) {
+        listener->insertCharacter((unsigned char) c, input, endPos);
+        break;
+      }
+      // send the following basic characters (until the next font) in one call
+      long runEnd=endPos;
+      if (fIt != zone.m_idFontMap.end() && zone.m_pos.begin()+fIt->first < runEnd)
+        runEnd=zone.m_pos.begin()+fIt->first;
+      cPos += long(sendCharacters(input, actPos, runEnd, '<', f))-1;
+      continue;
+    }
     }
     f << c;
   }
@@ -787,7 +823,12 @@ bool ZWrtText::sendHeaderFooter(bool header)
       }
       input->seek(actPos+1, librevenge::RVNG_SEEK_SET);
     default:
-      listener->insertCharacter((unsigned char) c, input, endPos);
+      if ((unsigned char) c < 0x20)
+        listener->insertCharacter((unsigned char) c, input, endPos);
+      else {
+        libmwaw::DebugStream f;
+        sendCharacters(input, actPos, endPos, '#', f);
+      }
       break;
     }
   }
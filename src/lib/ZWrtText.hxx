@@ -97,6 +97,9 @@ protected:
   bool sendText(int sectionId, MWAWEntry const &entry);
   //! check if a character after '<' corresponds to a text code
   TextCode isTextCode(MWAWInputStreamPtr &input, long endPos, MWAWEntry &dPos) const;
+  /** sends the basic characters which begin at pos until endPos, a control
+      character or stopChar, and returns the number of characters read */
+  size_t sendCharacters(MWAWInputStreamPtr &input, long pos, long endPos, char stopChar, libmwaw::DebugStream &f);
 
   //! read the header/footer zone
   bool readHFZone(MWAWEntry const &entry);
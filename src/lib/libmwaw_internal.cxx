@@ -37,6 +37,7 @@
 #include <sstream>
 
 #include <ctype.h>
+#include <string.h>
 #include <locale.h>
 
 #include <librevenge-stream/librevenge-stream.h>
@@ -95,6 +96,176 @@ void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
   outbuf[0] = uint8_t(val | first);
   for (i = 0; i < len; i++) buffer.append((char)outbuf[i]);
 }
+
+int encodeUTF8(uint32_t val, char *dst)
+{
+  if (val < 0x80) {
+    dst[0]=char(val);
+    return 1;
+  }
+  if (val < 0x800) {
+    dst[0]=char(0xc0 | (val>>6));
+    dst[1]=char(0x80 | (val&0x3f));
+    return 2;
+  }
+  if (val < 0x10000) {
+    dst[0]=char(0xe0 | (val>>12));
+    dst[1]=char(0x80 | ((val>>6)&0x3f));
+    dst[2]=char(0x80 | (val&0x3f));
+    return 3;
+  }
+  dst[0]=char(0xf0 | ((val>>18)&0x7));
+  dst[1]=char(0x80 | ((val>>12)&0x3f));
+  dst[2]=char(0x80 | ((val>>6)&0x3f));
+  dst[3]=char(0x80 | (val&0x3f));
+  return 4;
+}
+
+bool PackBitsDecoder::decode(unsigned char const *src, unsigned long srcSize, unsigned char *dst, unsigned long dstSize,
+                             bool untilEnd, bool clip)
+{
+  m_numRead=m_numWritten=0;
+  m_numSameRepeats=0;
+  if (!src) return false;
+  unsigned long const unitSize=(unsigned long) m_unitSize;
+  unsigned char const *lastRepeat=0;
+  while (untilEnd ? m_numRead<srcSize : m_numWritten<dstSize) {
+    if (m_numRead+1+unitSize > srcSize) return false;
+    unsigned char n=src[m_numRead++];
+    bool repeat=n>=0x81 || (n==0x80 && m_header80IsRepeat);
+    unsigned long count=repeat ? unsigned(0x101-n) : unsigned(n+1);
+    unsigned long numBytes=count*unitSize;
+    if (!repeat && m_numRead+numBytes > srcSize) return false;
+    unsigned long numCopy=numBytes;
+    if (m_numWritten+numBytes > dstSize) {
+      if (!clip) return false;
+      numCopy=dstSize-m_numWritten;
+    }
+    unsigned char const *data=src+m_numRead;
+    if (repeat) {
+      if (lastRepeat && memcmp(lastRepeat, data, unitSize)==0)
+        ++m_numSameRepeats;
+      lastRepeat=data;
+      if (dst && unitSize==1)
+        memset(dst+m_numWritten, *data, numCopy);
+      else if (dst) {
+        for (unsigned long i=0; i<numCopy; ++i)
+          dst[m_numWritten+i]=data[i%unitSize];
+      }
+      m_numRead+=unitSize;
+    }
+    else {
+      lastRepeat=0;
+      if (dst && numCopy)
+        memcpy(dst+m_numWritten, data, numCopy);
+      m_numRead+=numBytes;
+    }
+    m_numWritten+=numCopy;
+  }
+  return true;
+}
+
+/* implementation of a basic splay tree to decode a block
+   freely inspired from: ftp://ftp.cs.uiowa.edu/pub/jones/compress/minunsplay.c :
+
+   Author: Douglas Jones, Dept. of Comp. Sci., U. of Iowa, Iowa City, IA 52242.
+   Date: Nov. 5, 1990.
+         (derived from the Feb. 14 1990 version by stripping out irrelevancies)
+         (minor revision of Feb. 20, 1989 to add exit(0) at end of program).
+         (minor revision of Nov. 14, 1988 to detect corrupt input better).
+         (minor revision of Aug. 8, 1988 to eliminate unused vars, fix -c).
+   Copyright:  This material is derived from code Copyrighted 1988 by
+         Jeffrey Chilton and Douglas Jones.  That code contained a copyright
+         notice allowing copying for personal or research purposes, so long
+         as copies of the code were not sold for direct commercial advantage.
+         This version of the code has been stripped of most of the material
+         added by Jeff Chilton, and this release of the code may be used or
+         copied for any purpose, public or private.
+   Patents:  The algorithm central to this code is entirely the invention of
+         Douglas Jones, and it has not been patented.  Any patents claiming
+         to cover this material are invalid.
+   Exportability:  Splay-tree based compression algorithms may be used for
+         cryptography, and when used as such, they may not be exported from
+         the United States without appropriate approval.  All cryptographic
+         features of the original version of this code have been removed.
+   Language: C
+   Purpose: Data uncompression program, a companion to minsplay.c
+   Algorithm: Uses a splay-tree based prefix code.  For a full understanding
+          of the operation of this data compression scheme, refer to the paper
+          "Applications of Splay Trees to Data Compression" by Douglas W. Jones
+          in Communications of the ACM, Aug. 1988, pages 996-1007.
+*/
+SplayTreeDecoder::SplayTreeDecoder()
+{
+  reset();
+}
+
+void SplayTreeDecoder::reset()
+{
+  for (short i = 0; i < 514; ++i)
+    m_up[i] = short(i/2);
+  for (short j = 0; j < 257; ++j) {
+    m_left[j] = short(2 * j);
+    m_right[j] = short(2 * j + 1);
+  }
+}
+
+bool SplayTreeDecoder::decode(unsigned char const *src, unsigned long srcSize, std::vector<unsigned char> &dst)
+{
+  short const maxChar=256;
+  short const maxSucc=maxChar+1;
+  short const root = 0;
+
+  reset();
+  if (!src) return true;
+  dst.reserve(dst.size()+2*size_t(srcSize));
+  unsigned char const *end=src+srcSize;
+  unsigned int bitBuffer=0; // the remaining bits are stored in the high bits
+  int numBits=0;
+  while (src<end) {
+    short a = root;
+    do {  /* once for each bit on path */
+      if (numBits==0) {
+        if (src>=end) {
+          dst.push_back((unsigned char)a);
+          return false;
+        }
+        bitBuffer=*(src++);
+        numBits=8;
+      }
+      --numBits;
+      a = (bitBuffer & 0x80) ? m_right[a] : m_left[a];
+      bitBuffer <<= 1;
+    }
+    while (a <= maxChar);
+    dst.push_back((unsigned char)(a - maxSucc));
+
+    /* now splay tree about leaf a */
+    do {    /* walk up the tree semi-rotating pairs of nodes */
+      short c = m_up[a];
+      if (c == root)
+        break;
+      /* a pair remains */
+      short d = m_up[c];
+      short b = m_left[d];
+      if (c == b) {
+        b = m_right[d];
+        m_right[d] = a;
+      }
+      else
+        m_left[d] = a;
+      if (m_left[c] == a)
+        m_left[c] = b;
+      else
+        m_right[c] = b;
+      m_up[a] = d;
+      m_up[b] = c;
+      a = d;
+    }
+    while (a != root);
+  }
+  return true;
+}
 }
 
 namespace libmwaw
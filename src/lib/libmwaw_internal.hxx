@@ -147,6 +147,123 @@ namespace libmwaw
 uint8_t readU8(librevenge::RVNGInputStream *input);
 //! adds an unicode character to a string
 void appendUnicode(uint32_t val, librevenge::RVNGString &buffer);
+/** writes the utf8 encoding of an unicode character (less than 0x200000) in dst,
+    which must contain at least 4 free characters
+
+    \return the number of written characters */
+int encodeUTF8(uint32_t val, char *dst);
+
+/** a small class used to append a run of unicode characters to a string: the
+    characters are encoded in a local buffer which is appended when it is full */
+class UTF8Appender
+{
+public:
+  //! constructor
+  explicit UTF8Appender(librevenge::RVNGString &buffer) : m_buffer(buffer), m_numChar(0)
+  {
+  }
+  //! destructor: appends the remaining characters
+  ~UTF8Appender()
+  {
+    flush();
+  }
+  //! adds an unicode character
+  void append(uint32_t val)
+  {
+    m_numChar+=size_t(encodeUTF8(val, m_utf8+m_numChar));
+    if (m_numChar>=256) flush();
+  }
+  //! appends the buffered characters to the string
+  void flush()
+  {
+    if (!m_numChar) return;
+    m_utf8[m_numChar]=0;
+    m_buffer.append(m_utf8);
+    m_numChar=0;
+  }
+protected:
+  //! the final string
+  librevenge::RVNGString &m_buffer;
+  //! the local buffer
+  char m_utf8[256+8];
+  //! the number of characters in the local buffer
+  size_t m_numChar;
+private:
+  UTF8Appender(UTF8Appender const &orig);
+  UTF8Appender &operator=(UTF8Appender const &orig);
+};
+
+/** a PackBits decoder: each block begins with a byte n, if n<0x80, it is followed by
+    n+1 units to copy, if not, it is followed by a unit to repeat 0x101-n times */
+class PackBitsDecoder
+{
+public:
+  /** constructor given the unit size (1 for most bitmaps, 2 for 16 bits pixmaps, ...)
+
+      \note the PICT readers treat the header 0x80 as a 129 units repeat block, the
+      other readers as a 129 units literal block, see header80IsRepeat */
+  explicit PackBitsDecoder(int unitSize=1, bool header80IsRepeat=false) :
+    m_unitSize(unitSize < 1 ? 1 : unitSize), m_header80IsRepeat(header80IsRepeat), m_numRead(0), m_numWritten(0), m_numSameRepeats(0)
+  {
+  }
+  /** decompresses src in dst until dstSize bytes are written or, if untilEnd is set, until
+      all the src data are read. If dst is 0, the data are only checked.
+
+      \return false if a block is truncated or if a block does not fit in dst
+      (if clip is set, the data which do not fit are skipped)
+   */
+  bool decode(unsigned char const *src, unsigned long srcSize, unsigned char *dst, unsigned long dstSize,
+              bool untilEnd=false, bool clip=false);
+  //! returns the number of bytes read by the last decode call
+  unsigned long getNumRead() const
+  {
+    return m_numRead;
+  }
+  //! returns the number of bytes written (or checked) by the last decode call
+  unsigned long getNumWritten() const
+  {
+    return m_numWritten;
+  }
+  //! returns the number of successive repeat blocks which repeat the same unit in the last decode call
+  int getNumSameRepeats() const
+  {
+    return m_numSameRepeats;
+  }
+protected:
+  //! the unit size
+  int m_unitSize;
+  //! a flag to know if the header 0x80 defines a repeat block
+  bool m_header80IsRepeat;
+  //! the number of read bytes
+  unsigned long m_numRead;
+  //! the number of written bytes
+  unsigned long m_numWritten;
+  //! the number of successive repeat blocks which repeat the same unit
+  int m_numSameRepeats;
+};
+
+/** a splay-tree decoder: the data are coded with a prefix code which is
+    updated after each decoded character, see D. W. Jones, "Applications of
+    Splay Trees to Data Compression", CACM, Aug. 1988 */
+class SplayTreeDecoder
+{
+public:
+  //! constructor
+  SplayTreeDecoder();
+  /** decompresses src and appends the result to dst.
+
+      \return false if the last code is incomplete */
+  bool decode(unsigned char const *src, unsigned long srcSize, std::vector<unsigned char> &dst);
+protected:
+  //! resets the tree
+  void reset();
+  //! the left children
+  short m_left[257];
+  //! the right children
+  short m_right[257];
+  //! the parent of each node
+  short m_up[514];
+};
 }
 
 /* ---------- small enum/class ------------- */
@@ -417,6 +534,7 @@ class MWAWListener;
 class MWAWListManager;
 class MWAWParserState;
 class MWAWPresentationListener;
+class MWAWPropertyListCache;
 class MWAWRSRCParser;
 class MWAWSpreadsheetListener;
 class MWAWSubDocument;